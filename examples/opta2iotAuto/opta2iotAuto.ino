@@ -25,12 +25,26 @@
 // Create Opta object
 opta2iot::Opta opta;
 
+// Called from Opta loop for each MQTT message on a registered topic pattern
+void onCommand(const opta2iot::Opta::MqttMessage &message, void *context) {
+  if (Serial) {
+    Serial.print("| MQTT command on ");
+    Serial.print(message.topic);
+    Serial.print(": ");
+    Serial.write(message.payload, message.length);
+    Serial.println();
+  }
+}
+
 void setup() {
   // This executes all Opta setup stuff
   if (opta.setup()) {
 
     // Setup other stuff here ...
 
+    // Receive custom commands on <base_topic>/<device_id>/cmd/<anything>
+    opta.mqttOn(String(opta.configGetMqttBase() + opta.configGetDeviceId() + "/cmd/+").c_str(), onCommand);
+
     // Then launches Opta loop in a dedicated thread (required)
     opta.thread();
   }
@@ -12,6 +12,12 @@ void setup() {
    */
   if (opta.setup()
       && opta.rs485Setup()) {
+
+    /*
+     * Received frames end on bus silence by default, here they end on new line.
+     */
+    opta.rs485SetFraming(opta2iot::Opta::Rs485FramingDelimiter, '\n');
+
     opta.thread();
   }
 }
@@ -26,10 +32,11 @@ void loop() {
       String message = opta.configGetDeviceId();
 
       /**
-       * Try to send message till serial is avalable
+       * Queue message, it is sent in background once bus is free
        */
-      while (!opta.rs485Send(message)) { }
-      Serial.println("TX: " + message);
+      if (opta.rs485Send(message)) {
+        Serial.println("TX: " + message);
+      }
 
       lastSend = millis();
     }
@@ -40,12 +47,18 @@ void loop() {
     if (opta.rs485Incoming()) {
 
       /**
-       * Read last mesasge.
+       * Read oldest mesasge.
        *
-       * Read the message, erase it and allow opta to receive another message.
+       * Message is read in place from receive buffer, then released to free its room.
+       * opta.rs485Received() can be used instead to get a String copy.
        */
-      String message = opta.rs485Received();
-      Serial.println("RX: " + message);
+      opta2iot::Opta::Rs485Frame frame;
+      if (opta.rs485Peek(frame)) {
+        Serial.print("RX: ");
+        Serial.write(frame.data, frame.length);
+        Serial.println();
+        opta.rs485Release();
+      }
     }
   }
 }
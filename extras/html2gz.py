@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""opta2iot
+
+Arduino Opta Industrial IoT gateway
+
+Generate src/html_gz.h from src/html.h:
+gzip compressed copies of web pages and their ETag.
+
+Run it after any change to src/html.h:
+    python3 extras/html2gz.py
+"""
+
+import gzip
+import os
+import re
+import zlib
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+SOURCE = os.path.join(ROOT, "html.h")
+TARGET = os.path.join(ROOT, "html_gz.h")
+
+# assets served compressed
+COMPRESSED = ["web_home_html", "web_device_html", "web_style_css"]
+# assets served with ETag only (already compressed)
+BINARY = ["web_favicon_hex"]
+
+HEADER = """/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+/**
+ * DO NOT EDIT, this file is generated from html.h by extras/html2gz.py
+ */
+
+#ifndef OPTA2IOT_HTML_GZ_H
+#define OPTA2IOT_HTML_GZ_H
+
+#include <stdint.h>
+
+namespace opta2iot {
+"""
+
+FOOTER = """
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_HTML_GZ_H
+"""
+
+
+def array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02X" % b for b in data[i:i + 16]))
+    return "constexpr uint8_t %s[] = {\n%s\n};\n" % (name, ",\n".join(lines))
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        source = f.read()
+
+    texts = dict(re.findall(r'const char (\w+)\[\] = R"rawliteral\((.*?)\)rawliteral";', source, re.S))
+    binaries = dict(re.findall(r'const char (\w+)\[\] = \{(.*?)\};', source, re.S))
+
+    out = [HEADER]
+    for name in COMPRESSED:
+        raw = texts[name].encode("utf-8")
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        out.append("\n// %s: %d bytes, %d bytes compressed\n" % (name, len(raw), len(packed)))
+        out.append(array(name + "_gz", packed))
+        out.append('constexpr char %s_etag[] = "%08x";\n' % (name, zlib.crc32(raw)))
+
+    for name in BINARY:
+        raw = bytes(int(x, 16) for x in re.findall(r"0x[0-9A-Fa-f]{2}", binaries[name]))
+        out.append("\n// %s: %d bytes\n" % (name, len(raw)))
+        out.append('constexpr char %s_etag[] = "%08x";\n' % (name, zlib.crc32(raw)))
+
+    out.append(FOOTER)
+
+    with open(TARGET, "w", encoding="utf-8", newline="\r\n") as f:
+        f.write("".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+/**
+ * Host stand-in for Arduino Client: bytes sent by the remote peer are queued with
+ * arrive() and read by the code under test, bytes written by the code are kept in sent.
+ */
+
+#ifndef OPTA2IOT_TEST_CLIENT_H
+#define OPTA2IOT_TEST_CLIENT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class FakeClient {
+
+public:
+
+  std::string incoming;
+  std::string sent;
+  size_t position = 0;
+  size_t reads = 0;
+
+  void arrive(const std::string &data) {
+    incoming.append(data);
+  }
+
+  void arrive(const uint8_t *data, size_t size) {
+    incoming.append((const char *)data, size);
+  }
+
+  int available() {
+    return incoming.size() - position;
+  }
+
+  int read(uint8_t *buffer, size_t size) {
+    size_t left = incoming.size() - position;
+    if (size > left) {
+      size = left;
+    }
+    incoming.copy((char *)buffer, size, position);
+    position += size;
+    reads++;
+
+    return size;
+  }
+
+  int read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+
+  size_t write(const uint8_t *buffer, size_t size) {
+    sent.append((const char *)buffer, size);
+
+    return size;
+  }
+
+  void clear() {
+    incoming.clear();
+    sent.clear();
+    position = 0;
+  }
+};
+
+#endif  // #ifndef OPTA2IOT_TEST_CLIENT_H
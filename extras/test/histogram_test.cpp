@@ -0,0 +1,141 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include "test.h"
+#include "histogram.h"
+
+using opta2iot::Histogram;
+
+TEST(smallValues) {
+  for (uint32_t v = 0; v < 8; v++) {
+    CHECK_EQ(Histogram::bucket(v), v);
+    CHECK_EQ(Histogram::lower(v), v);
+  }
+}
+
+TEST(powerOfTwoBoundaries) {
+  for (uint8_t k = 2; k < 24; k++) {
+    uint32_t p = 1UL << k;
+    uint8_t index = (k - 1) * 4;
+
+    // 2^k opens a new log2 bucket, 2^k - 1 closes the previous one
+    CHECK_EQ(Histogram::bucket(p), index);
+    CHECK_EQ(Histogram::bucket(p - 1), index - 1);
+    CHECK_EQ(Histogram::lower(index), p);
+
+    // 4 linear sub buckets per power of two
+    for (uint8_t sub = 0; sub < 4; sub++) {
+      uint32_t low = Histogram::lower(index + sub);
+      CHECK_EQ(low, p + sub * (p / 4));
+      CHECK_EQ(Histogram::bucket(low), index + sub);
+    }
+  }
+}
+
+TEST(lowerMatchesBucket) {
+  for (uint8_t i = 0; i < Histogram::BucketsMax; i++) {
+    CHECK_EQ(Histogram::bucket(Histogram::lower(i)), i);
+    if (i) {
+      CHECK_EQ(Histogram::bucket(Histogram::lower(i) - 1), i - 1);
+    }
+  }
+}
+
+TEST(topBucket) {
+  uint8_t top = Histogram::BucketsMax - 1;
+  CHECK_EQ(Histogram::lower(top), 7UL << 21);
+  CHECK_EQ(Histogram::bucket((1UL << 24) - 1), top);
+
+  // 2^24 and above are all kept in the last bucket
+  CHECK_EQ(Histogram::bucket(1UL << 24), top);
+  CHECK_EQ(Histogram::bucket(1UL << 31), top);
+  CHECK_EQ(Histogram::bucket(0xFFFFFFFFUL), top);
+
+  Histogram h;
+  h.add(1UL << 20);
+  h.add(1UL << 26);
+  CHECK_EQ(h.max(), 1UL << 26);
+  CHECK_EQ(h.percentile(100), 1UL << 26);  // top bucket upper bound is max
+}
+
+TEST(statsAndReset) {
+  Histogram h;
+  CHECK_EQ(h.count(), 0);
+  CHECK_EQ(h.average(), 0);
+  CHECK_EQ(h.percentile(50), 0);
+
+  h.add(10);
+  h.add(20);
+  h.add(30);
+  CHECK_EQ(h.count(), 3);
+  CHECK_EQ(h.min(), 10);
+  CHECK_EQ(h.max(), 30);
+  CHECK_EQ(h.average(), 20);
+
+  h.reset();
+  CHECK_EQ(h.count(), 0);
+  CHECK_EQ(h.min(), 0);
+  CHECK_EQ(h.max(), 0);
+  CHECK_EQ(h.percentile(99), 0);
+
+  // min is taken from first value after reset, not from 0
+  h.add(50);
+  CHECK_EQ(h.min(), 50);
+  CHECK_EQ(h.percentile(1), 50);
+}
+
+TEST(percentiles) {
+  Histogram h;
+  for (uint32_t v = 1; v <= 100; v++) {
+    h.add(v);
+  }
+
+  // upper bound of the bucket holding the rank, never above max
+  CHECK_EQ(h.percentile(0), 1);
+  CHECK_EQ(h.percentile(1), 1);
+  CHECK_EQ(h.percentile(4), 4);
+  CHECK_EQ(h.percentile(50), 55);   // 50 is in [48, 55]
+  CHECK_EQ(h.percentile(90), 95);   // 90 is in [80, 95]
+  CHECK_EQ(h.percentile(99), 100);  // 99 is in [96, 111], capped to max
+  CHECK_EQ(h.percentile(100), 100);
+
+  for (uint8_t p = 1; p <= 100; p++) {
+    uint32_t value = h.percentile(p);
+    CHECK(value >= p);
+    CHECK(value <= p + p / 4);
+  }
+}
+
+TEST(singleBucket) {
+  Histogram h;
+  for (int i = 0; i < 1000; i++) {
+    h.add(1000);
+  }
+  CHECK_EQ(h.percentile(50), 1000);
+  CHECK_EQ(h.percentile(99), 1000);
+  CHECK_EQ(h.average(), 1000);
+}
+
+int main() {
+  RUN(smallValues);
+  RUN(powerOfTwoBoundaries);
+  RUN(lowerMatchesBucket);
+  RUN(topBucket);
+  RUN(statsAndReset);
+  RUN(percentiles);
+  RUN(singleBucket);
+
+  return TEST_END;
+}
@@ -0,0 +1,393 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <chrono>
+#include <string>
+
+#include "test.h"
+#include "client.h"
+#include "define.h"
+#include "http.h"
+
+using namespace opta2iot;
+
+typedef HttpRequest<OPTA2IOT_WEB_LINE> Request;
+typedef HttpBody<OPTA2IOT_WEB_BODY> Body;
+
+static const char *Auth = "YWRtaW46YWRtaW4=";  // admin:admin
+
+static std::string base64(const std::string &in) {
+  static const char *table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t i = 0;
+  for (; i + 2 < in.size(); i += 3) {
+    uint32_t v = (uint8_t)in[i] << 16 | (uint8_t)in[i + 1] << 8 | (uint8_t)in[i + 2];
+    out += table[v >> 18];
+    out += table[(v >> 12) & 63];
+    out += table[(v >> 6) & 63];
+    out += table[v & 63];
+  }
+  if (i + 1 == in.size()) {
+    uint32_t v = (uint8_t)in[i] << 16;
+    out += table[v >> 18];
+    out += table[(v >> 12) & 63];
+    out += "==";
+  } else if (i + 2 == in.size()) {
+    uint32_t v = (uint8_t)in[i] << 16 | (uint8_t)in[i + 1] << 8;
+    out += table[v >> 18];
+    out += table[(v >> 12) & 63];
+    out += table[(v >> 6) & 63];
+    out += '=';
+  }
+
+  return out;
+}
+
+static std::string post(const std::string &body, const char *auth = Auth) {
+  return "POST /form HTTP/1.1\r\nAuthorization: Basic " + std::string(auth) + "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+TEST(getRequest) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive("\r\nGET /device?x=1 HTTP/1.1\r\nHost: 192.168.1.2\r\nauthorization: basic YWRtaW46YWRtaW4=\r\n"
+                "Accept-Encoding: gzip, deflate\r\nIf-None-Match: \"abc\"\r\nUpgrade: WebSocket\r\n"
+                "Sec-WebSocket-Key:   dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\nOrigin: http://192.168.1.2\r\n\r\n");
+
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(!req.post);
+  CHECK(std::string(req.path) == "/device");
+  CHECK(req.auth);
+  CHECK(req.gzip);
+  CHECK(std::string(req.match) == "\"abc\"");
+  CHECK(req.upgrade);
+  CHECK(std::string(req.key) == "dGhlIHNhbXBsZSBub25jZQ==");
+  CHECK_EQ(req.version, 13);
+  CHECK(std::string(req.host) == "192.168.1.2");
+  CHECK(std::string(req.origin) == "http://192.168.1.2");
+  CHECK_EQ(req.consumed(), client.incoming.size());
+
+  // done request does not read any more
+  client.arrive("GET / HTTP/1.1\r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(client.available() > 0);
+}
+
+TEST(splitByteByByte) {
+  std::string data = "GET /config HTTP/1.1\r\nAuthorization: Basic YWRtaW46YWRtaW4=\r\n\r\n";
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  for (size_t i = 0; i < data.size(); i++) {
+    CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpMore);
+    client.arrive(data.substr(i, 1));
+  }
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(std::string(req.path) == "/config");
+  CHECK(req.auth);
+}
+
+TEST(badCredentials) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive("GET / HTTP/1.1\r\nAuthorization: Basic YWRtaW46d3Jvbmc=\r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(!req.auth);
+
+  req.begin(nullptr, 1000);
+  client.clear();
+  client.arrive("GET / HTTP/1.1\r\nAuthorization: Basic \r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(!req.auth);
+}
+
+TEST(longestCredentials) {
+  // sizes of ConfigRecord deviceUser and devicePassword, without null
+  std::string auth = base64(std::string(32, 'u') + ":" + std::string(64, 'p'));
+  CHECK_EQ(auth.size(), 132);
+
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(auth.c_str(), 1000);
+  client.arrive("GET / HTTP/1.1\r\nAuthorization: Basic " + auth + "\r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(req.auth);
+
+  // the old 128 bytes line truncated it
+  HttpRequest<128> small;
+  small.begin(auth.c_str(), 1000);
+  client.position = 0;
+  CHECK_EQ(small.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(!small.auth);
+}
+
+TEST(longLinesAndPaths) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive("GET /" + std::string(300, 'a') + " HTTP/1.1\r\nUser-Agent: " + std::string(500, 'x') + "\r\nAuthorization: Basic YWRtaW46YWRtaW4=\r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(std::string(req.path) == "");
+  CHECK(req.auth);
+
+  req.begin(Auth, 1000);
+  client.clear();
+  client.arrive("DELETE /config HTTP/1.1\r\n\r\n");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(std::string(req.path) == "");
+  CHECK(!req.post);
+}
+
+TEST(budgetPerCall) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  std::string data = "GET / HTTP/1.1\r\n";
+  for (int i = 0; i < 40; i++) {
+    data += "X-Header-" + std::to_string(i) + ": some value to fill the request\r\n";
+  }
+  data += "\r\n";
+  client.arrive(data);
+
+  // at most budget bytes per call
+  size_t calls = 0;
+  Request::Result result;
+  do {
+    size_t before = req.consumed();
+    result = req.read(client, body, 0, 0, 512);
+    CHECK(req.consumed() - before <= 512);
+    calls++;
+  } while (result == Request::HttpMore && calls < 100);
+  CHECK_EQ(result, Request::HttpReady);
+  CHECK_EQ(calls, (data.size() + 511) / 512);
+}
+
+TEST(bodyWithHeaders) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive(post("{\"deviceId\":\"1\"}") + "extra");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(req.post);
+  CHECK(std::string(req.path) == "/form");
+  CHECK_EQ(req.received, 16);
+  CHECK(std::string(body.data) == "{\"deviceId\":\"1\"}");  // not past its length
+  body.release(0);
+}
+
+TEST(bodyOverLoops) {
+  std::string json = "{\"data\":\"" + std::string(1500, 'z') + "\"}";
+  std::string data = post(json);
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 10000);
+
+  // body arrives in small packets, one packet per loop
+  Request::Result result = Request::HttpMore;
+  uint32_t now = 0;
+  for (size_t i = 0; i < data.size() && result == Request::HttpMore; i += 100) {
+    client.arrive(data.substr(i, 100));
+    result = req.read(client, body, 2, now, 512);
+    now += 10;
+  }
+  CHECK_EQ(result, Request::HttpReady);
+  CHECK_EQ(req.received, json.size());
+  CHECK(std::string(body.data) == json);
+  body.release(2);
+}
+
+TEST(bodyTooLarge) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive("POST /form HTTP/1.1\r\nAuthorization: Basic YWRtaW46YWRtaW4=\r\nContent-Length: " + std::to_string(OPTA2IOT_WEB_BODY + 1) + "\r\n\r\n{");
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpTooLarge);
+
+  // buffer was not taken
+  CHECK(body.acquire(1));
+  body.release(1);
+
+  // exact size is accepted
+  req.begin(Auth, 1000);
+  client.clear();
+  client.arrive(post(std::string(OPTA2IOT_WEB_BODY, 'a')));
+  Request::Result result;
+  while ((result = req.read(client, body, 0, 0, 512)) == Request::HttpMore) {
+  }
+  CHECK_EQ(result, Request::HttpReady);
+  CHECK_EQ(strlen(body.data), OPTA2IOT_WEB_BODY);
+  body.release(0);
+}
+
+TEST(bodyTimeout) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  std::string data = post(std::string(100, 'a'));
+  client.arrive(data.substr(0, data.size() - 10));
+  CHECK_EQ(req.read(client, body, 0, 5000, 4096), Request::HttpMore);
+  CHECK_EQ(req.read(client, body, 0, 5500, 4096), Request::HttpMore);
+  CHECK_EQ(req.read(client, body, 0, 6000, 4096), Request::HttpMore);
+  CHECK_EQ(req.read(client, body, 0, 6001, 4096), Request::HttpTimeout);
+  body.release(0);
+}
+
+TEST(bodyBusy) {
+  FakeClient first, second;
+  Body body;
+  Request a, b;
+  a.begin(Auth, 1000);
+  b.begin(Auth, 1000);
+
+  std::string data = post(std::string(300, 'a'));
+  first.arrive(data.substr(0, data.size() - 100));
+  CHECK_EQ(a.read(first, body, 0, 0, 4096), Request::HttpMore);
+
+  // second body while first one is not complete
+  second.arrive(post(std::string(10, 'b')));
+  CHECK_EQ(b.read(second, body, 1, 0, 4096), Request::HttpBusy);
+
+  first.arrive(data.substr(data.size() - 100));
+  CHECK_EQ(a.read(first, body, 0, 0, 4096), Request::HttpReady);
+  body.release(0);
+
+  b.begin(Auth, 1000);
+  second.clear();
+  second.arrive(post(std::string(10, 'b')));
+  CHECK_EQ(b.read(second, body, 1, 0, 4096), Request::HttpReady);
+  CHECK(std::string(body.data) == std::string(10, 'b'));
+  body.release(1);
+}
+
+TEST(unauthenticatedPostHasNoBody) {
+  FakeClient client;
+  Body body;
+  Request req;
+  req.begin(Auth, 1000);
+  client.arrive(post("{}", "bad"));
+  CHECK_EQ(req.read(client, body, 0, 0, 4096), Request::HttpReady);
+  CHECK(!req.auth);
+  CHECK_EQ(req.received, 0);
+
+  // body buffer is still free
+  CHECK(body.acquire(3));
+  body.release(3);
+}
+
+TEST(concurrentConnections) {
+  // loop gives each connection one read per pass, like webLoop(), with random packet sizes
+  const int connections = OPTA2IOT_WEB_CLIENTS;
+  const int requests = 2000;
+  FakeClient clients[connections];
+  Request reqs[connections];
+  std::string pending[connections];
+  std::string expected[connections];
+  int done = 0, busy = 0, gets = 0, posts = 0, started = 0;
+  uint32_t seed = 12345;
+  auto random = [&](uint32_t max) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % max;
+  };
+  Body body;
+
+  auto start = [&](int i) {
+    reqs[i].begin(Auth, OPTA2IOT_WEB_BODY_TIMEOUT);
+    clients[i].clear();
+    if (random(3) == 0) {
+      expected[i] = "{\"n\":" + std::to_string(started) + ",\"pad\":\"" + std::string(random(1800), 'p') + "\"}";
+      pending[i] = post(expected[i]);
+    } else {
+      expected[i] = "";
+      pending[i] = "GET /data HTTP/1.1\r\nHost: opta\r\nAuthorization: Basic YWRtaW46YWRtaW4=\r\nAccept-Encoding: gzip\r\n\r\n";
+    }
+    started++;
+  };
+
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < connections; i++) {
+    start(i);
+  }
+  uint32_t now = 0, passes = 0;
+  while (done < requests && passes < 10000000) {
+    passes++;
+    now++;
+    for (int i = 0; i < connections; i++) {
+      if (!pending[i].empty()) {
+        size_t size = 1 + random(pending[i].size() < 700 ? pending[i].size() : 700);
+        clients[i].arrive(pending[i].substr(0, size));
+        pending[i].erase(0, size);
+      }
+
+      Request::Result result = reqs[i].read(clients[i], body, i, now, OPTA2IOT_WEB_CHUNK);
+      if (result == Request::HttpMore) {
+        continue;
+      }
+      if (result == Request::HttpBusy) {
+        busy++;
+      } else {
+        CHECK_EQ(result, Request::HttpReady);
+        CHECK(reqs[i].auth);
+        if (expected[i].empty()) {
+          CHECK(std::string(reqs[i].path) == "/data");
+          CHECK(reqs[i].gzip);
+          gets++;
+        } else {
+          CHECK(std::string(body.data) == expected[i]);
+          posts++;
+        }
+        done++;
+      }
+      body.release(i);
+      start(i);
+    }
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+  CHECK_EQ(done, requests);
+  CHECK(gets > 0);
+  CHECK(posts > 0);
+  printf("  %d requests (%d GET, %d POST, %d busy) on %d connections in %u passes, %lld us, %.0f requests/s\n",
+         done, gets, posts, busy, connections, passes, (long long)us, us ? done * 1e6 / us : 0.0);
+}
+
+int main() {
+  RUN(getRequest);
+  RUN(splitByteByByte);
+  RUN(badCredentials);
+  RUN(longestCredentials);
+  RUN(longLinesAndPaths);
+  RUN(budgetPerCall);
+  RUN(bodyWithHeaders);
+  RUN(bodyOverLoops);
+  RUN(bodyTooLarge);
+  RUN(bodyTimeout);
+  RUN(bodyBusy);
+  RUN(unauthenticatedPostHasNoBody);
+  RUN(concurrentConnections);
+
+  return TEST_END;
+}
@@ -0,0 +1,358 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "client.h"
+#include "modbustcp.h"
+
+using namespace opta2iot;
+
+// Server tables of an Opta with 8 inputs, 4 outputs and a few registers
+struct Tables {
+  std::vector<uint8_t> coils = std::vector<uint8_t>(4, 0);
+  std::vector<uint8_t> inputs = std::vector<uint8_t>(8, 0);
+  std::vector<uint16_t> holding = std::vector<uint16_t>(200, 0);
+  std::vector<uint16_t> input = std::vector<uint16_t>(130, 0);
+  size_t writes = 0;
+
+  size_t coilsNum() { return coils.size(); }
+  size_t discreteInputsNum() { return inputs.size(); }
+  size_t holdingRegistersNum() { return holding.size(); }
+  size_t inputRegistersNum() { return input.size(); }
+  long coilRead(int address) { return coils[address]; }
+  long discreteInputRead(int address) { return inputs[address]; }
+  long holdingRegisterRead(int address) { return holding[address]; }
+  long inputRegisterRead(int address) { return input[address]; }
+  void coilWrite(int address, uint8_t value) { coils[address] = value; writes++; }
+  void holdingRegisterWrite(int address, uint16_t value) { holding[address] = value; writes++; }
+};
+
+// Server side of a connection, same loop as Opta::modbusTcpProcess()
+struct Connection {
+  uint8_t buffer[ModbusTcp::AduMax * 2];
+  size_t length = 0;
+  bool closed = false;
+
+  void process(Tables &tables, FakeClient &client, size_t burst = 4) {
+    int available = client.available();
+    size_t space = sizeof(buffer) - length;
+    if (available > 0 && space > 0) {
+      length += client.read(buffer + length, (size_t)available < space ? available : space);
+    }
+    for (size_t frames = 0; frames < burst; frames++) {
+      int size = ModbusTcp::frame(buffer, length);
+      if (size < 0) {
+        closed = true;
+
+        return;
+      }
+      if (size == 0) {
+        break;
+      }
+      uint8_t response[ModbusTcp::AduMax];
+      client.write(response, ModbusTcp::respond(tables, buffer, size, response));
+      length -= size;
+      memmove(buffer, buffer + size, length);
+    }
+  }
+};
+
+// Master request: MBAP header, unit 1, then PDU
+static std::string request(uint16_t transaction, const std::string &pdu, uint16_t protocol = 0) {
+  std::string out;
+  out += (char)(transaction >> 8);
+  out += (char)(transaction & 0xFF);
+  out += (char)(protocol >> 8);
+  out += (char)(protocol & 0xFF);
+  out += (char)((pdu.size() + 1) >> 8);
+  out += (char)((pdu.size() + 1) & 0xFF);
+  out += (char)1;
+  out += pdu;
+
+  return out;
+}
+
+static std::string pdu(uint8_t function, uint16_t address, uint16_t count, const std::string &data = "") {
+  std::string out;
+  out += (char)function;
+  out += (char)(address >> 8);
+  out += (char)(address & 0xFF);
+  out += (char)(count >> 8);
+  out += (char)(count & 0xFF);
+  out += data;
+
+  return out;
+}
+
+// Answer one request, get response PDU after checking MBAP header
+static std::string ask(Tables &tables, const std::string &data, uint16_t transaction = 0x1234) {
+  std::string req = request(transaction, data);
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)req.data(), req.size()), req.size());
+  uint8_t response[ModbusTcp::AduMax];
+  size_t length = ModbusTcp::respond(tables, (const uint8_t *)req.data(), req.size(), response);
+  CHECK(length >= 9);
+  CHECK_EQ((response[0] << 8) | response[1], transaction);
+  CHECK_EQ((response[2] << 8) | response[3], 0);
+  CHECK_EQ((response[4] << 8) | response[5], length - 6);
+  CHECK_EQ(response[6], 1);
+
+  return std::string((const char *)response + 7, length - 7);
+}
+
+static std::string exception(uint8_t function, uint8_t code) {
+  return std::string(1, (char)(function | 0x80)) + (char)code;
+}
+
+TEST(readBits) {
+  Tables tables;
+  tables.coils = { 1, 0, 1, 1 };
+  tables.inputs = { 0, 1, 0, 0, 0, 0, 0, 1 };
+
+  CHECK(ask(tables, pdu(0x01, 0, 4)) == std::string("\x01\x01\x0D", 3));
+  CHECK(ask(tables, pdu(0x01, 2, 2)) == std::string("\x01\x01\x03", 3));
+  CHECK(ask(tables, pdu(0x02, 0, 8)) == std::string("\x02\x01\x82", 3));
+  CHECK(ask(tables, pdu(0x02, 7, 1)) == std::string("\x02\x01\x01", 3));
+}
+
+TEST(readRegisters) {
+  Tables tables;
+  tables.holding[10] = 0xABCD;
+  tables.holding[11] = 0x0102;
+  tables.input[129] = 0x8000;
+
+  CHECK(ask(tables, pdu(0x03, 10, 2)) == std::string("\x03\x04\xAB\xCD\x01\x02", 6));
+  CHECK(ask(tables, pdu(0x04, 129, 1)) == std::string("\x04\x02\x80\x00", 4));
+
+  // largest read fits a whole ADU
+  std::string response = ask(tables, pdu(0x04, 0, 125));
+  CHECK_EQ(response.size(), 2 + 250);
+  CHECK_EQ((uint8_t)response[1], 250);
+}
+
+TEST(writeSingle) {
+  Tables tables;
+
+  CHECK(ask(tables, pdu(0x05, 3, 0xFF00)) == pdu(0x05, 3, 0xFF00));
+  CHECK_EQ(tables.coils[3], 1);
+  CHECK(ask(tables, pdu(0x05, 3, 0x0000)) == pdu(0x05, 3, 0x0000));
+  CHECK_EQ(tables.coils[3], 0);
+
+  CHECK(ask(tables, pdu(0x06, 199, 0xBEEF)) == pdu(0x06, 199, 0xBEEF));
+  CHECK_EQ(tables.holding[199], 0xBEEF);
+}
+
+TEST(writeMultiple) {
+  Tables tables;
+
+  CHECK(ask(tables, pdu(0x0F, 0, 4, std::string("\x01\x0A", 2))) == pdu(0x0F, 0, 4));
+  CHECK(tables.coils == std::vector<uint8_t>({ 0, 1, 0, 1 }));
+
+  CHECK(ask(tables, pdu(0x10, 20, 2, std::string("\x04\x12\x34\x56\x78", 5))) == pdu(0x10, 20, 2));
+  CHECK_EQ(tables.holding[20], 0x1234);
+  CHECK_EQ(tables.holding[21], 0x5678);
+
+  // largest write fits a whole ADU
+  std::string data(1, (char)246);
+  for (int i = 0; i < 123; i++) {
+    data += (char)0;
+    data += (char)i;
+  }
+  CHECK(ask(tables, pdu(0x10, 0, 123, data)) == pdu(0x10, 0, 123));
+  CHECK_EQ(tables.holding[122], 122);
+}
+
+TEST(illegalFunction) {
+  Tables tables;
+  const uint8_t functions[] = { 0x00, 0x07, 0x08, 0x11, 0x16, 0x17, 0x2B, 0x7F };
+  for (uint8_t function : functions) {
+    CHECK(ask(tables, pdu(function, 0, 1)) == exception(function, 1));
+  }
+  // even without data
+  CHECK(ask(tables, std::string(1, (char)0x41)) == exception(0x41, 1));
+  CHECK_EQ(tables.writes, 0);
+}
+
+TEST(illegalAddress) {
+  Tables tables;
+
+  CHECK(ask(tables, pdu(0x01, 0, 5)) == exception(0x01, 2));
+  CHECK(ask(tables, pdu(0x01, 4, 1)) == exception(0x01, 2));
+  CHECK(ask(tables, pdu(0x01, 0xFFFF, 1)) == exception(0x01, 2));  // no 16 bits overflow
+  CHECK(ask(tables, pdu(0x02, 1, 8)) == exception(0x02, 2));
+  CHECK(ask(tables, pdu(0x03, 199, 2)) == exception(0x03, 2));
+  CHECK(ask(tables, pdu(0x04, 6, 125)) == exception(0x04, 2));
+  CHECK(ask(tables, pdu(0x05, 4, 0xFF00)) == exception(0x05, 2));
+  CHECK(ask(tables, pdu(0x06, 200, 1)) == exception(0x06, 2));
+  CHECK(ask(tables, pdu(0x0F, 3, 2, std::string("\x01\x03", 2))) == exception(0x0F, 2));
+  CHECK(ask(tables, pdu(0x10, 199, 2, std::string("\x04\x00\x01\x00\x02", 5))) == exception(0x10, 2));
+
+  // nothing written on rejected requests
+  CHECK_EQ(tables.writes, 0);
+}
+
+TEST(illegalValue) {
+  Tables tables;
+
+  // quantities out of protocol limits
+  CHECK(ask(tables, pdu(0x01, 0, 0)) == exception(0x01, 3));
+  CHECK(ask(tables, pdu(0x02, 0, 2001)) == exception(0x02, 3));
+  CHECK(ask(tables, pdu(0x03, 0, 0)) == exception(0x03, 3));
+  CHECK(ask(tables, pdu(0x04, 0, 126)) == exception(0x04, 3));
+  CHECK(ask(tables, pdu(0x0F, 0, 0, std::string("\x00", 1))) == exception(0x0F, 3));
+  CHECK(ask(tables, pdu(0x10, 0, 124, std::string("\xF8\x00\x00", 3))) == exception(0x10, 3));
+
+  // coil value is only ON or OFF
+  CHECK(ask(tables, pdu(0x05, 0, 0x0001)) == exception(0x05, 3));
+  CHECK(ask(tables, pdu(0x05, 0, 0xFFFF)) == exception(0x05, 3));
+
+  // byte count not matching quantity or data
+  CHECK(ask(tables, pdu(0x0F, 0, 4, std::string("\x02\x0F\x00", 3))) == exception(0x0F, 3));
+  CHECK(ask(tables, pdu(0x0F, 0, 4, std::string("\x01", 1))) == exception(0x0F, 3));
+  CHECK(ask(tables, pdu(0x10, 0, 2, std::string("\x04\x00\x01", 3))) == exception(0x10, 3));
+  CHECK(ask(tables, pdu(0x10, 0, 2, std::string("\x02\x00\x01\x00\x02", 5))) == exception(0x10, 3));
+  CHECK(ask(tables, pdu(0x10, 0, 1)) == exception(0x10, 3));
+
+  // truncated or padded PDU
+  CHECK(ask(tables, pdu(0x03, 0, 1).substr(0, 3)) == exception(0x03, 3));
+  CHECK(ask(tables, pdu(0x03, 0, 1) + "x") == exception(0x03, 3));
+  CHECK(ask(tables, pdu(0x06, 0, 1).substr(0, 4)) == exception(0x06, 3));
+
+  CHECK_EQ(tables.writes, 0);
+}
+
+TEST(framing) {
+  std::string req = request(1, pdu(0x03, 0, 1));
+  const uint8_t *data = (const uint8_t *)req.data();
+
+  // incomplete requests wait for more
+  for (size_t length = 0; length < req.size(); length++) {
+    CHECK_EQ(ModbusTcp::frame(data, length), 0);
+  }
+  CHECK_EQ(ModbusTcp::frame(data, req.size()), req.size());
+  CHECK_EQ(ModbusTcp::frame(data, req.size() + 3), req.size());
+
+  // not Modbus protocol
+  std::string other = request(1, pdu(0x03, 0, 1), 0x0001);
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)other.data(), other.size()), -1);
+  other = request(1, pdu(0x03, 0, 1), 0x0100);
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)other.data(), other.size()), -1);
+
+  // length field too short for a function or longer than an ADU
+  std::string header("\x00\x01\x00\x00\x00\x01\x01\x03", 8);
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)header.data(), header.size()), -1);
+  header[5] = 2;
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)header.data(), header.size()), 8);
+  header[5] = (char)254;
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)header.data(), header.size()), 0);
+  header[5] = (char)255;
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)header.data(), header.size()), -1);
+  header[4] = 1;
+  header[5] = 0;
+  CHECK_EQ(ModbusTcp::frame((const uint8_t *)header.data(), header.size()), -1);
+}
+
+TEST(pipelinedAndSplit) {
+  Tables tables;
+  tables.holding[0] = 7;
+  FakeClient client;
+  Connection conn;
+
+  // three requests in one segment, byte by byte, then a bad one
+  std::string all = request(1, pdu(0x03, 0, 1)) + request(2, pdu(0x06, 0, 8)) + request(3, pdu(0x03, 0, 1));
+  client.arrive(all);
+  conn.process(tables, client);
+  CHECK_EQ(conn.length, 0);
+  CHECK(client.sent == request(1, std::string("\x03\x02\x00\x07", 4)) + request(2, pdu(0x06, 0, 8)) + request(3, std::string("\x03\x02\x00\x08", 4)));
+
+  client.clear();
+  for (char c : request(4, pdu(0x01, 0, 4))) {
+    CHECK(client.sent.empty());
+    client.arrive(std::string(1, c));
+    conn.process(tables, client);
+  }
+  CHECK(client.sent == request(4, std::string("\x01\x01\x00", 3)));
+
+  // burst limit leaves remaining requests for next pass
+  client.clear();
+  for (int i = 0; i < 6; i++) {
+    client.arrive(request(10 + i, pdu(0x03, 0, 1)));
+  }
+  conn.process(tables, client, 4);
+  CHECK_EQ(client.sent.size(), 4 * 11);
+  conn.process(tables, client, 4);
+  CHECK_EQ(client.sent.size(), 6 * 11);
+  CHECK_EQ(conn.length, 0);
+
+  // bad protocol after a good request closes once good one is answered
+  client.clear();
+  client.arrive(request(20, pdu(0x03, 0, 1)) + request(21, pdu(0x03, 0, 1), 5));
+  conn.process(tables, client);
+  CHECK_EQ(client.sent.size(), 11);
+  CHECK(conn.closed);
+}
+
+TEST(masterBenchmark) {
+  // host master polls like a SCADA: read all registers, read bits, write a block, in turn
+  Tables tables;
+  FakeClient client;
+  Connection conn;
+  const int requests = 200000;
+  uint8_t response[ModbusTcp::AduMax];
+  std::string block(1, (char)20);
+  block.append(20, '\x5A');
+
+  auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < requests; n++) {
+    uint16_t transaction = n & 0xFFFF;
+    switch (n % 4) {
+      case 0: client.arrive(request(transaction, pdu(0x04, 0, 125))); break;
+      case 1: client.arrive(request(transaction, pdu(0x03, 0, 100))); break;
+      case 2: client.arrive(request(transaction, pdu(0x02, 0, 8))); break;
+      default: client.arrive(request(transaction, pdu(0x10, 50, 10, block))); break;
+    }
+    conn.process(tables, client);
+
+    // master reads answer back
+    if (client.sent.size() < 9 || ((uint8_t)client.sent[0] << 8 | (uint8_t)client.sent[1]) != transaction || (client.sent[7] & 0x80)) {
+      CHECK(false);
+      break;
+    }
+    client.sent.copy((char *)response, client.sent.size());
+    client.clear();
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  CHECK_EQ(tables.writes, requests / 4 * 10);
+  printf("  %d requests in %lld us, %.0f requests/s\n", requests, (long long)us, requests * 1000000.0 / (us ? us : 1));
+}
+
+int main() {
+  RUN(readBits);
+  RUN(readRegisters);
+  RUN(writeSingle);
+  RUN(writeMultiple);
+  RUN(illegalFunction);
+  RUN(illegalAddress);
+  RUN(illegalValue);
+  RUN(framing);
+  RUN(pipelinedAndSplit);
+  RUN(masterBenchmark);
+
+  return TEST_END;
+}
@@ -0,0 +1,139 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <thread>
+
+#include "test.h"
+#include "reconnect.h"
+
+using opta2iot::Reconnect;
+
+TEST(firstAttemptIsImmediate) {
+  Reconnect r(1000);
+  CHECK(!r.connecting());
+  CHECK(r.due(0));
+  CHECK(r.due(12345));
+}
+
+TEST(noAttemptWhileConnecting) {
+  Reconnect r(1000);
+  bool result = true;
+  r.start(100);
+  CHECK(r.connecting());
+
+  // worker still busy, whatever the time
+  CHECK(!r.due(100));
+  CHECK(!r.due(5000));
+  CHECK(!r.finished(result));
+  CHECK(r.connecting());
+
+  r.finish(false);
+  CHECK(r.finished(result));
+  CHECK(!result);
+  CHECK(!r.connecting());
+
+  // result is given only once
+  CHECK(!r.finished(result));
+}
+
+TEST(failedAttemptWaitsInterval) {
+  Reconnect r(1000);
+  bool result;
+  r.start(100);
+  r.finish(false);
+  r.finished(result);
+
+  // interval counts from the attempt start
+  CHECK(!r.due(600));
+  CHECK(!r.due(1100));
+  CHECK(r.due(1101));
+
+  r.start(1101);
+  r.finish(false);
+  r.finished(result);
+  CHECK(!r.due(2000));
+  CHECK(r.due(2102));
+}
+
+TEST(lossAfterConnectionIsImmediate) {
+  Reconnect r(1000);
+  bool result;
+  r.start(100);
+  r.finish(true);
+  CHECK(r.finished(result));
+  CHECK(result);
+
+  // loop keeps telling the link is up, then it drops
+  r.connected();
+  CHECK(r.due(150));
+
+  // but a new failure waits again
+  r.start(150);
+  r.finish(false);
+  r.finished(result);
+  CHECK(!r.due(200));
+}
+
+TEST(clockWrapAround) {
+  Reconnect r(1000);
+  bool result;
+  uint32_t start = 0xFFFFFF00u;
+  r.start(start);
+  r.finish(false);
+  r.finished(result);
+  CHECK(!r.due(start + 500));
+  CHECK(!r.due(start + 1000));
+  CHECK(r.due(start + 1001));
+}
+
+TEST(disabled) {
+  Reconnect r(0);
+  CHECK(!r.due(0));
+  CHECK(!r.due(100000));
+}
+
+TEST(workerThread) {
+  // worker reports from another thread, loop polls
+  Reconnect r(10);
+  bool result = false;
+  uint32_t loops = 0;
+  for (uint32_t attempt = 0; attempt < 100; attempt++) {
+    r.start(attempt * 100);
+    std::thread worker([&r, attempt]() {
+      r.finish(attempt % 2);
+    });
+    while (!r.finished(result)) {
+      CHECK(!r.due(attempt * 100 + 50));
+      loops++;
+      std::this_thread::yield();
+    }
+    worker.join();
+    CHECK_EQ(result, attempt % 2);
+    CHECK(!r.connecting());
+  }
+  CHECK(loops > 0);
+}
+
+int main() {
+  RUN(firstAttemptIsImmediate);
+  RUN(noAttemptWhileConnecting);
+  RUN(failedAttemptWaitsInterval);
+  RUN(lossAfterConnectionIsImmediate);
+  RUN(clockWrapAround);
+  RUN(disabled);
+  RUN(workerThread);
+
+  return TEST_END;
+}
@@ -0,0 +1,183 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "test.h"
+#include "ring.h"
+
+using opta2iot::Ring;
+
+TEST(emptyRing) {
+  Ring<int, 4> r;
+  int v = -1;
+  CHECK(r.empty());
+  CHECK_EQ(r.size(), 0);
+  CHECK(!r.pop(v));
+  CHECK_EQ(v, -1);
+  CHECK(r.peek() == nullptr);
+  r.skip(3);
+  CHECK(r.empty());
+  CHECK_EQ(r.capacity(), 4);
+}
+
+TEST(fullRing) {
+  Ring<int, 4> r;
+  for (int i = 0; i < 4; i++) {
+    CHECK(r.push(i));
+  }
+  CHECK_EQ(r.size(), 4);
+
+  // full ring refuses new items and keeps the old ones
+  CHECK(!r.push(99));
+  CHECK_EQ(r.size(), 4);
+
+  int v;
+  CHECK(r.pop(v));
+  CHECK_EQ(v, 0);
+  CHECK(r.push(4));
+  CHECK(!r.push(5));
+
+  for (int i = 1; i <= 4; i++) {
+    CHECK(r.pop(v));
+    CHECK_EQ(v, i);
+  }
+  CHECK(!r.pop(v));
+}
+
+TEST(wrapAround) {
+  Ring<int, 8> r;
+  int next = 0, expected = 0, v;
+
+  // many laps with a changing fill level, order is kept across the wrap
+  for (int lap = 0; lap < 100; lap++) {
+    int in = 1 + lap % 8;
+    for (int i = 0; i < in && r.push(next); i++) {
+      next++;
+    }
+    int out = 1 + (lap * 3) % 8;
+    for (int i = 0; i < out && r.pop(v); i++) {
+      CHECK_EQ(v, expected);
+      expected++;
+    }
+    CHECK_EQ(r.size(), (size_t)(next - expected));
+  }
+  while (r.pop(v)) {
+    CHECK_EQ(v, expected);
+    expected++;
+  }
+  CHECK_EQ(expected, next);
+  CHECK(next > 8 * 10);
+}
+
+TEST(peekSkipClear) {
+  Ring<int, 4> r;
+  r.push(10);
+  r.push(11);
+  r.push(12);
+  CHECK(r.peek(0) && *r.peek(0) == 10);
+  CHECK(r.peek(2) && *r.peek(2) == 12);
+  CHECK(r.peek(3) == nullptr);
+
+  r.skip(2);
+  CHECK_EQ(r.size(), 1);
+  CHECK(*r.peek() == 12);
+
+  // skip more than available stops at head
+  r.skip(10);
+  CHECK(r.empty());
+  CHECK(r.push(13));
+  CHECK(*r.peek() == 13);
+
+  r.push(14);
+  r.clear();
+  CHECK(r.empty());
+  CHECK(r.push(15));
+  CHECK_EQ(r.size(), 1);
+}
+
+// Producer thread plays the interrupt, consumer thread the loop
+static void producerConsumer(bool retry, uint32_t &received, uint32_t &lost, bool &ordered) {
+  static Ring<uint32_t, 256> r;
+  const uint32_t total = 200000;
+  uint32_t last = 0;
+  received = lost = 0;
+  ordered = true;
+  r.clear();
+
+  std::atomic<bool> done{ false };
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&]() {
+    for (uint32_t i = 1; i <= total; i++) {
+      while (!r.push(i)) {
+        if (!retry) {
+          lost++;  // like ioCapture()
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+    done.store(true);
+  });
+
+  uint32_t v;
+  while (true) {
+    bool finished = done.load();
+    if (r.pop(v)) {
+      ordered = ordered && v > last;
+      last = v;
+      received++;
+    } else if (finished) {
+      break;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  printf("  %u items, %u lost, %lld us, %.1f Mitems/s\n", total, lost, (long long)us, us ? (double)received / us : 0.0);
+}
+
+TEST(producerConsumerLossless) {
+  uint32_t received, lost;
+  bool ordered;
+  producerConsumer(true, received, lost, ordered);
+  CHECK(ordered);
+  CHECK_EQ(lost, 0);
+  CHECK_EQ(received, 200000);
+}
+
+TEST(producerConsumerOverflow) {
+  // every item is either received in order or counted as lost, never both
+  uint32_t received, lost;
+  bool ordered;
+  producerConsumer(false, received, lost, ordered);
+  CHECK(ordered);
+  CHECK_EQ(received + lost, 200000);
+}
+
+int main() {
+  RUN(emptyRing);
+  RUN(fullRing);
+  RUN(wrapAround);
+  RUN(peekSkipClear);
+  RUN(producerConsumerLossless);
+  RUN(producerConsumerOverflow);
+
+  return TEST_END;
+}
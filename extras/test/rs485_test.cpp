@@ -0,0 +1,324 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+#include "define.h"
+#include "rs485.h"
+
+using namespace opta2iot;
+
+typedef Rs485Receiver<OPTA2IOT_RS485_RX_SIZE, OPTA2IOT_RS485_FRAMES> Receiver;
+
+// 19200 bauds, 8E1: 11 bits characters
+static const uint32_t charTime = 573;
+static const uint32_t t35 = 2006;
+
+// Loopback bus: bytes written by a sender reach the UART driver buffer one character time apart,
+// they are readable by receiver once their arrival time is reached
+class Bus {
+
+public:
+
+  std::atomic<uint32_t> now{ 0 };
+
+  // Send a frame once bus is free after given silence, get end time
+  uint32_t send(const std::string &data, uint32_t silence) {
+    uint32_t time = _free + silence;
+    for (char c : data) {
+      time += charTime;
+      _arrivals.push_back(time);
+      _bytes.push_back((uint8_t)c);
+    }
+    _free = time;
+
+    return time;
+  }
+
+  int available() {
+    size_t count = 0;
+    while (_position + count < _arrivals.size() && _arrivals[_position + count] <= now) {
+      count++;
+    }
+
+    return count;
+  }
+
+  int read() {
+    return available() > 0 ? _bytes[_position++] : -1;
+  }
+
+private:
+
+  std::vector<uint32_t> _arrivals;
+  std::vector<uint8_t> _bytes;
+  size_t _position = 0;
+  uint32_t _free = 100000;
+};
+
+// Drain at fixed period until given time, as receive thread does
+static void run(Receiver &rx, Bus &bus, uint32_t until, uint32_t period = OPTA2IOT_RS485_POLL * 1000) {
+  while (bus.now < until) {
+    bus.now += period;
+    rx.drain(bus, bus.now, charTime, t35);
+  }
+}
+
+static std::vector<std::string> frames(Receiver &rx) {
+  std::vector<std::string> out;
+  const uint8_t *data;
+  size_t length;
+  while (rx.peek(data, length)) {
+    out.push_back(std::string((const char *)data, length));
+    rx.release();
+  }
+
+  return out;
+}
+
+static std::string message(int n, size_t length) {
+  std::string out;
+  for (size_t i = 0; i < length; i++) {
+    out += (char)('A' + (n + i) % 26);
+  }
+
+  return out;
+}
+
+TEST(gapFrames) {
+  Receiver rx;
+  Bus bus;
+  std::vector<std::string> sent;
+
+  // Modbus like request and reply turnarounds, down to just above t3.5 plus drain period
+  uint32_t end = 0;
+  for (int n = 0; n < 12; n++) {
+    sent.push_back(message(n, 1 + n * 7));
+    end = bus.send(sent.back(), t35 + 1000 + n * 700);
+  }
+  run(rx, bus, end + t35 + 2000);
+
+  CHECK(frames(rx) == sent);
+  CHECK_EQ(rx.overruns(), 0);
+}
+
+TEST(gapParameter) {
+  Receiver rx;
+  Bus bus;
+  rx.begin(Receiver::FramingGap, 10000);
+
+  // 5 ms silences are inside frames with a 10 ms gap
+  bus.send("abc", 0);
+  bus.send("def", 5000);
+  uint32_t end = bus.send("ghi", 20000);
+  run(rx, bus, end + 12000);
+
+  std::vector<std::string> received = frames(rx);
+  CHECK_EQ(received.size(), 2);
+  CHECK(received.size() == 2 && received[0] == "abcdef" && received[1] == "ghi");
+}
+
+TEST(lateDrain) {
+  Receiver rx;
+  Bus bus;
+
+  // first frame is drained in time, drain is then held 40 ms while the second frame arrives:
+  // its bytes are timed back from drain time and the silence before them still ends first frame
+  uint32_t end = bus.send("first", 0);
+  run(rx, bus, end + 500);
+  CHECK(rx.empty());
+  end = bus.send("second", 8000);
+  bus.now = end + 30000;
+  rx.drain(bus, bus.now, charTime, t35);
+  run(rx, bus, bus.now + t35 + 1000);
+
+  std::vector<std::string> received = frames(rx);
+  CHECK(received.size() == 2 && received[0] == "first" && received[1] == "second");
+
+  // a frame continuing at a drain late by less than the gap is not split
+  end = bus.send("contin", 20000);
+  bus.now = end - 3 * charTime;
+  rx.drain(bus, bus.now, charTime, t35);
+  end = bus.send("ued", 0);
+  bus.now = end + 1000;
+  rx.drain(bus, bus.now, charTime, t35);
+  run(rx, bus, bus.now + t35 + 1000);
+  received = frames(rx);
+  CHECK(received.size() == 1 && received[0] == "continued");
+}
+
+TEST(limitSilenceInsideLateDrain) {
+  Receiver rx;
+  Bus bus;
+
+  // documented limit: two frames both waiting in driver buffer at a late drain cannot be split
+  bus.send("one", 0);
+  uint32_t end = bus.send("two", 8000);
+  bus.now = end + 1000;
+  rx.drain(bus, bus.now, charTime, t35);
+  run(rx, bus, bus.now + t35 + 1000);
+
+  std::vector<std::string> received = frames(rx);
+  CHECK(received.size() == 1 && received[0] == "onetwo");
+
+  // and end of a frame found by a drain late by more than the gap is taken as a new frame
+  end = bus.send("three", 20000);
+  bus.now = end - 2 * charTime;
+  rx.drain(bus, bus.now, charTime, t35);
+  bus.now = end + 10000;
+  rx.drain(bus, bus.now, charTime, t35);
+  run(rx, bus, bus.now + t35 + 1000);
+  received = frames(rx);
+  CHECK(received.size() == 2 && received[0] == "thr" && received[1] == "ee");
+}
+
+TEST(delimiterFrames) {
+  Receiver rx;
+  Bus bus;
+  rx.begin(Receiver::FramingDelimiter, '\n');
+
+  // silence does not end a frame, empty frames are not stored
+  bus.send("hello ", 0);
+  bus.send("world\n\n", 50000);
+  uint32_t end = bus.send("again\nrest", 0);
+  run(rx, bus, end + 50000);
+
+  std::vector<std::string> received = frames(rx);
+  CHECK(received.size() == 2 && received[0] == "hello world" && received[1] == "again");
+
+  // pending "rest" is dropped by a new framing
+  rx.begin(Receiver::FramingDelimiter, ';');
+  end = bus.send("x;", 60000);
+  run(rx, bus, end + 1000);
+  received = frames(rx);
+  CHECK(received.size() == 1 && received[0] == "x");
+}
+
+TEST(lengthFrames) {
+  Receiver rx;
+  Bus bus;
+  rx.begin(Receiver::FramingLength, 5000);
+
+  bus.send(std::string("\x03" "abc" "\x02" "de", 7), 0);
+  // uncompleted frame is dropped after silence, next length resyncs
+  bus.send(std::string("\x04" "fg", 3), 1000);
+  uint32_t end = bus.send(std::string("\x01" "h", 2), 6000);
+  run(rx, bus, end + 10000);
+
+  std::vector<std::string> received = frames(rx);
+  CHECK(received.size() == 3 && received[0] == "abc" && received[1] == "de" && received[2] == "h");
+  CHECK_EQ(rx.overruns(), 1);
+
+  // without silence parameter, frame waits whatever the silence
+  rx.begin(Receiver::FramingLength, 0);
+  bus.send(std::string("\x04" "ij", 3), 0);
+  end = bus.send("kl", 100000);
+  run(rx, bus, end + 1000);
+  received = frames(rx);
+  CHECK(received.size() == 1 && received[0] == "ijkl");
+  CHECK_EQ(rx.overruns(), 1);
+}
+
+TEST(overruns) {
+  Receiver rx;
+  Bus bus;
+
+  // frame larger than buffer is dropped at its end, next one is kept
+  bus.send(std::string(OPTA2IOT_RS485_RX_SIZE + 10, 'x'), 0);
+  uint32_t end = bus.send("ok", 5000);
+  run(rx, bus, end + 5000);
+  std::vector<std::string> received = frames(rx);
+  CHECK(received.size() == 1 && received[0] == "ok");
+  CHECK_EQ(rx.overruns(), 1);
+
+  // frames queue full
+  for (int n = 0; n < OPTA2IOT_RS485_FRAMES + 3; n++) {
+    end = bus.send(message(n, 4), 5000);
+  }
+  run(rx, bus, end + 5000);
+  CHECK_EQ(rx.size(), OPTA2IOT_RS485_FRAMES);
+  CHECK_EQ(rx.overruns(), 4);
+  received = frames(rx);
+  CHECK(received.front() == message(0, 4) && received.back() == message(OPTA2IOT_RS485_FRAMES - 1, 4));
+
+  // frames reaching buffer end go to its start once released
+  for (int n = 0; n < 40; n++) {
+    end = bus.send(message(n, 100), 5000);
+    run(rx, bus, end + 5000);
+    received = frames(rx);
+    CHECK(received.size() == 1 && received[0] == message(n, 100));
+  }
+  CHECK_EQ(rx.overruns(), 4);
+}
+
+TEST(threadedLoopback) {
+  // receive thread drains a simulated bus while loop reads frames, as on device
+  Receiver rx;
+  Bus bus;
+  const int count = 5000;
+  std::vector<std::string> sent;
+  uint32_t end = 0;
+  for (int n = 0; n < count; n++) {
+    sent.push_back(message(n, 1 + n % 200));
+    end = bus.send(sent.back(), t35 + 1000 + (n % 5) * 500);
+  }
+
+  std::atomic<bool> done{ false };
+  std::thread drain([&]() {
+    while (bus.now < end + t35 + 2000) {
+      // wait for reader when frames queue is full, a real bus would overrun instead
+      if (rx.size() < OPTA2IOT_RS485_FRAMES) {
+        bus.now += OPTA2IOT_RS485_POLL * 1000;
+        rx.drain(bus, bus.now, charTime, t35);
+      }
+      std::this_thread::yield();
+    }
+    done = true;
+  });
+
+  std::vector<std::string> received;
+  while (!done || !rx.empty()) {
+    const uint8_t *data;
+    size_t length;
+    if (rx.peek(data, length)) {
+      received.push_back(std::string((const char *)data, length));
+      rx.release();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  drain.join();
+
+  CHECK_EQ(received.size(), sent.size());
+  CHECK(received == sent);
+  CHECK_EQ(rx.overruns(), 0);
+}
+
+int main() {
+  RUN(gapFrames);
+  RUN(gapParameter);
+  RUN(lateDrain);
+  RUN(limitSilenceInsideLateDrain);
+  RUN(delimiterFrames);
+  RUN(lengthFrames);
+  RUN(overruns);
+  RUN(threadedLoopback);
+
+  return TEST_END;
+}
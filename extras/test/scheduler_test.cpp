@@ -0,0 +1,152 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include "test.h"
+#include "scheduler.h"
+
+using opta2iot::Scheduler;
+
+TEST(priorityOrder) {
+  Scheduler s;
+  s.add(7, 10, 0);
+  s.add(3, 10, 0);
+  s.add(5, 10, 0);
+
+  // all due at start, given back in registration order, then nothing
+  CHECK_EQ(s.next(0), 7);
+  CHECK_EQ(s.next(0), 3);
+  CHECK_EQ(s.next(0), 5);
+  CHECK_EQ(s.next(0), -1);
+}
+
+TEST(higherPriorityFirst) {
+  Scheduler s;
+  s.add(1, 10, 0);
+  s.add(2, 4, 0);
+  CHECK_EQ(s.next(0), 1);
+  CHECK_EQ(s.next(0), 2);
+
+  // only low priority task due
+  CHECK_EQ(s.next(4), 2);
+  CHECK_EQ(s.next(4), -1);
+
+  // both due, high priority one goes first
+  CHECK_EQ(s.next(10), 1);
+  CHECK_EQ(s.next(10), 2);
+  CHECK_EQ(s.next(10), -1);
+}
+
+TEST(idleUntilDeadline) {
+  Scheduler s;
+  CHECK_EQ(s.idle(0, 50), 50);
+
+  s.add(1, 20, 0);
+  s.add(2, 30, 0);
+  CHECK_EQ(s.idle(0, 50), 0);
+
+  s.next(0);
+  s.next(0);
+  CHECK_EQ(s.idle(0, 50), 20);
+  CHECK_EQ(s.idle(5, 50), 15);
+  CHECK_EQ(s.idle(5, 10), 10);
+  CHECK_EQ(s.idle(20, 50), 0);
+  CHECK_EQ(s.idle(25, 50), 0);
+}
+
+TEST(steadyRate) {
+  Scheduler s;
+  s.add(1, 10, 0);
+  CHECK_EQ(s.next(0), 1);
+
+  // a little late, next deadline stays on the period grid
+  CHECK_EQ(s.next(13), 1);
+  CHECK_EQ(s.next(19), -1);
+  CHECK_EQ(s.idle(19, 100), 1);
+  CHECK_EQ(s.next(20), 1);
+}
+
+TEST(overrunDoesNotCatchUp) {
+  Scheduler s;
+  s.add(1, 10, 0);
+  CHECK_EQ(s.next(0), 1);
+
+  // several periods missed, run once then wait a full period
+  CHECK_EQ(s.next(55), 1);
+  CHECK_EQ(s.next(55), -1);
+  CHECK_EQ(s.idle(55, 100), 10);
+  CHECK_EQ(s.next(64), -1);
+  CHECK_EQ(s.next(65), 1);
+}
+
+TEST(clockWrapAround) {
+  Scheduler s;
+  uint32_t start = 0xFFFFFFF0u;
+  s.add(1, 32, start);
+  CHECK_EQ(s.next(start), 1);
+
+  CHECK_EQ(s.next(start + 31), -1);
+  CHECK_EQ(s.idle(start + 20, 100), 12);
+  CHECK_EQ(s.next(start + 32), 1);  // deadline past 0
+}
+
+TEST(wakeDisableAndPeriod) {
+  Scheduler s;
+  s.add(1, 100, 0);
+  s.add(2, 100, 0);
+  s.next(0);
+  s.next(0);
+
+  s.wake(2, 10);
+  CHECK_EQ(s.idle(10, 100), 0);
+  CHECK_EQ(s.next(10), 2);
+
+  s.setEnabled(1, false);
+  CHECK_EQ(s.next(100), -1);
+  CHECK_EQ(s.idle(100, 50), 10);
+  s.setEnabled(1, true);
+  CHECK_EQ(s.next(100), 1);
+
+  s.setPeriod(1, 5);
+  CHECK_EQ(s.next(104), -1);  // new period applies after next run
+  CHECK_EQ(s.next(110), 2);
+  CHECK_EQ(s.next(200), 1);
+  CHECK_EQ(s.idle(200, 50), 5);
+
+  // unknown task is ignored
+  s.wake(9, 0);
+  s.setEnabled(9, false);
+}
+
+TEST(tasksLimit) {
+  Scheduler s;
+  for (size_t i = 0; i < Scheduler::TasksMax; i++) {
+    CHECK(s.add(i, 1, 0));
+  }
+  CHECK(!s.add(99, 1, 0));
+  CHECK_EQ(s.size(), Scheduler::TasksMax);
+}
+
+int main() {
+  RUN(priorityOrder);
+  RUN(higherPriorityFirst);
+  RUN(idleUntilDeadline);
+  RUN(steadyRate);
+  RUN(overrunDoesNotCatchUp);
+  RUN(clockWrapAround);
+  RUN(wakeDisableAndPeriod);
+  RUN(tasksLimit);
+
+  return TEST_END;
+}
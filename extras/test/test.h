@@ -0,0 +1,60 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+/**
+ * Minimal host test helpers, no dependency.
+ *
+ * Each test file is its own executable, main() returns TEST_END.
+ */
+
+#ifndef OPTA2IOT_TEST_H
+#define OPTA2IOT_TEST_H
+
+#include <stdio.h>
+
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(cond) \
+  do { \
+    testChecks++; \
+    if (!(cond)) { \
+      testFailures++; \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { \
+    testChecks++; \
+    long long _a = (long long)(a), _b = (long long)(b); \
+    if (_a != _b) { \
+      testFailures++; \
+      printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+    } \
+  } while (0)
+
+#define TEST(name) static void name()
+
+#define RUN(name) \
+  do { \
+    int _before = testFailures; \
+    name(); \
+    printf("%s %s\n", testFailures == _before ? "ok  " : "FAIL", #name); \
+  } while (0)
+
+#define TEST_END (printf("%d checks, %d failures\n", testChecks, testFailures), testFailures ? 1 : 0)
+
+#endif  // #ifndef OPTA2IOT_TEST_H
@@ -0,0 +1,339 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#include <chrono>
+#include <string>
+
+#include "test.h"
+#include "client.h"
+#include "define.h"
+#include "websocket.h"
+
+using namespace opta2iot;
+
+typedef WebSocketReader<OPTA2IOT_WEB_FRAME> Reader;
+
+// Client frame, masked as browsers do
+static std::string frame(uint8_t opcode, const std::string &payload, bool fin = true, bool masked = true, int lengthBytes = 0) {
+  const uint8_t mask[4] = { 0x37, 0xFA, 0x21, 0x3D };
+  std::string out;
+  out += (char)((fin ? 0x80 : 0) | opcode);
+  uint8_t bit = masked ? 0x80 : 0;
+  if (lengthBytes == 8) {
+    out += (char)(bit | 127);
+    for (int i = 7; i >= 0; i--) {
+      out += (char)(((uint64_t)payload.size() >> (i * 8)) & 0xFF);
+    }
+  } else if (lengthBytes == 2 || payload.size() > 125) {
+    out += (char)(bit | 126);
+    out += (char)(payload.size() >> 8);
+    out += (char)(payload.size() & 0xFF);
+  } else {
+    out += (char)(bit | payload.size());
+  }
+  if (masked) {
+    out.append((const char *)mask, 4);
+  }
+  for (size_t i = 0; i < payload.size(); i++) {
+    out += (char)(payload[i] ^ (masked ? mask[i % 4] : 0));
+  }
+
+  return out;
+}
+
+static std::string text(Reader &reader) {
+  return std::string((const char *)reader.payload(), reader.size());
+}
+
+TEST(wholeFrame) {
+  FakeClient client;
+  Reader reader;
+  reader.begin();
+  client.arrive(frame(0x1, "{\"O1\":1}"));
+  size_t budget = 512;
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(reader.fin());
+  CHECK_EQ(reader.opcode(), 0x1);
+  CHECK(text(reader) == "{\"O1\":1}");
+  CHECK_EQ(budget, 512 - 14);
+
+  // nothing more
+  CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+}
+
+TEST(emptyFrame) {
+  FakeClient client;
+  Reader reader;
+  reader.begin();
+  client.arrive(frame(0x9, ""));
+  size_t budget = 512;
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK_EQ(reader.opcode(), 0x9);
+  CHECK_EQ(reader.size(), 0);
+}
+
+TEST(splitEverywhere) {
+  // frames with 7 bits and 16 bits lengths, cut at every position, header included
+  std::string payloads[] = { "{\"O2\":0}", std::string(OPTA2IOT_WEB_FRAME - 8, 'y'), "a" };
+  for (int lengthBytes = 0; lengthBytes <= 2; lengthBytes += 2) {
+    for (const std::string &payload : payloads) {
+      std::string data = frame(0x1, payload, true, true, lengthBytes);
+      if (data.size() > OPTA2IOT_WEB_FRAME) {
+        continue;
+      }
+      for (size_t cut = 1; cut < data.size(); cut++) {
+        FakeClient client;
+        Reader reader;
+        reader.begin();
+        size_t budget = 512;
+        client.arrive(data.substr(0, cut));
+        CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+        client.arrive(data.substr(cut));
+        CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+        CHECK(text(reader) == payload);
+      }
+    }
+  }
+}
+
+TEST(extendedLengthByteByByte) {
+  std::string payload(OPTA2IOT_WEB_FRAME - 8, 'z');
+  std::string data = frame(0x1, payload, true, true, 2);
+  FakeClient client;
+  Reader reader;
+  reader.begin();
+  size_t budget = 512;
+  for (size_t i = 0; i < data.size() - 1; i++) {
+    client.arrive(data.substr(i, 1));
+    CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+  }
+  client.arrive(data.substr(data.size() - 1));
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(text(reader) == payload);
+
+  // short payload in a 16 bits length is accepted
+  client.arrive(frame(0x1, "hi", true, true, 2));
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(text(reader) == "hi");
+}
+
+TEST(severalFramesAtOnce) {
+  FakeClient client;
+  Reader reader;
+  reader.begin();
+  client.arrive(frame(0x1, "one") + frame(0x9, "ping") + frame(0x1, "three") + frame(0x8, "\x03\xe8"));
+  size_t budget = 512;
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(text(reader) == "one");
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK_EQ(reader.opcode(), 0x9);
+  CHECK(text(reader) == "ping");
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(text(reader) == "three");
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK_EQ(reader.opcode(), 0x8);
+  CHECK_EQ(reader.size(), 2);
+  CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+  CHECK_EQ(reader.consumed(), client.incoming.size());
+}
+
+TEST(budgetIsShared) {
+  FakeClient client;
+  Reader reader;
+  reader.begin();
+  std::string data = frame(0x1, std::string(100, 'a'));
+  client.arrive(data + data);
+
+  size_t budget = data.size() + 10;
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+  CHECK_EQ(budget, 0);
+  CHECK_EQ(client.available(), data.size() - 10);
+
+  budget = 512;
+  CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  CHECK(text(reader) == std::string(100, 'a'));
+}
+
+TEST(unsupportedFrames) {
+  size_t budget;
+  {
+    // unmasked client frame
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x1, "abc", true, false));
+    budget = 512;
+    CHECK_EQ(reader.read(client, budget), Reader::SocketTooBig);
+  }
+  {
+    // 64 bits length
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x1, "abc", true, true, 8));
+    budget = 512;
+    CHECK_EQ(reader.read(client, budget), Reader::SocketTooBig);
+  }
+  {
+    // larger than buffer, known from 7 bits length
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x1, std::string(OPTA2IOT_WEB_FRAME - 5, 'a')));
+    budget = 512;
+    CHECK_EQ(reader.read(client, budget), Reader::SocketTooBig);
+  }
+  {
+    // larger than buffer, known only once 16 bits length is received
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    std::string data = frame(0x1, std::string(1000, 'a'));
+    client.arrive(data.substr(0, 3));
+    budget = 512;
+    CHECK_EQ(reader.read(client, budget), Reader::SocketMore);
+    client.arrive(data.substr(3));
+    CHECK_EQ(reader.read(client, budget), Reader::SocketTooBig);
+  }
+  {
+    // largest frame that fits
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x1, std::string(OPTA2IOT_WEB_FRAME - 6, 'a')));
+    budget = 512;
+    CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+  }
+}
+
+TEST(controlFrames) {
+  size_t budget = 512;
+  {
+    // fragmented control frame
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x9, "ping", false));
+    CHECK_EQ(reader.read(client, budget), Reader::SocketProtocolError);
+  }
+  {
+    // control frame with extended length, its payload must fit in 125 bytes
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0xA, std::string(OPTA2IOT_WEB_FRAME - 8, 'p'), true, true, 2));
+    CHECK_EQ(reader.read(client, budget), Reader::SocketProtocolError);
+  }
+  {
+    // fragmented data frame is given to caller, which closes with 1003
+    FakeClient client;
+    Reader reader;
+    reader.begin();
+    client.arrive(frame(0x1, "part", false));
+    CHECK_EQ(reader.read(client, budget), Reader::SocketFrame);
+    CHECK(!reader.fin());
+  }
+}
+
+TEST(serverHeader) {
+  uint8_t out[4];
+  CHECK_EQ(Reader::header(out, 0x1, 5), 2);
+  CHECK_EQ(out[0], 0x81);
+  CHECK_EQ(out[1], 5);
+
+  CHECK_EQ(Reader::header(out, 0xA, 125), 2);
+  CHECK_EQ(out[0], 0x8A);
+  CHECK_EQ(out[1], 125);
+
+  CHECK_EQ(Reader::header(out, 0x1, 126), 4);
+  CHECK_EQ(out[1], 126);
+  CHECK_EQ(out[2], 0);
+  CHECK_EQ(out[3], 126);
+
+  CHECK_EQ(Reader::header(out, 0x1, 2560), 4);
+  CHECK_EQ(out[2], 0x0A);
+  CHECK_EQ(out[3], 0x00);
+}
+
+TEST(loopbackLatency) {
+  // client sends a command, server decodes it and echoes a pong like on a ping
+  FakeClient toServer, toClient;
+  Reader reader;
+  reader.begin();
+  const int frames = 20000;
+  uint32_t seed = 1;
+  int received = 0;
+  double worst = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < frames; n++) {
+    seed = seed * 1103515245 + 12345;
+    std::string payload = "{\"O" + std::to_string(1 + n % 4) + "\":" + std::to_string(n % 2) + "}";
+    std::string data = frame(n % 10 ? 0x1 : 0x9, payload);
+
+    // random split in two TCP segments
+    size_t cut = 1 + (seed >> 16) % (data.size() - 1);
+    auto sent = std::chrono::steady_clock::now();
+    toServer.arrive(data.substr(0, cut));
+    size_t budget = OPTA2IOT_WEB_CHUNK;
+    CHECK_EQ(reader.read(toServer, budget), Reader::SocketMore);
+    toServer.arrive(data.substr(cut));
+    if (reader.read(toServer, budget) != Reader::SocketFrame) {
+      CHECK(false);
+      break;
+    }
+    uint8_t header[4];
+    size_t size = Reader::header(header, reader.opcode() == 0x9 ? 0xA : 0x1, reader.size());
+    toClient.write(header, size);
+    toClient.write(reader.payload(), reader.size());
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - sent).count();
+    worst = ns > worst ? ns : worst;
+
+    CHECK(text(reader) == payload);
+    received++;
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  // echoed frames are well formed server frames
+  const std::string &out = toClient.sent;
+  size_t position = 0;
+  int echoed = 0;
+  while (position + 2 <= out.size()) {
+    size_t length = out[position + 1] & 0x7F;
+    CHECK((uint8_t)out[position] == 0x81 || (uint8_t)out[position] == 0x8A);
+    position += 2 + length;
+    echoed++;
+  }
+  CHECK_EQ(position, out.size());
+  CHECK_EQ(echoed, frames);
+  CHECK_EQ(received, frames);
+  printf("  %d frames in %lld us, %.0f ns per frame, worst %.0f ns\n", received, (long long)us, us * 1000.0 / received, worst);
+}
+
+int main() {
+  RUN(wholeFrame);
+  RUN(emptyFrame);
+  RUN(splitEverywhere);
+  RUN(extendedLengthByteByByte);
+  RUN(severalFramesAtOnce);
+  RUN(budgetIsShared);
+  RUN(unsupportedFrames);
+  RUN(controlFrames);
+  RUN(serverHeader);
+  RUN(loopbackLatency);
+
+  return TEST_END;
+}
@@ -44,6 +44,11 @@
 #define OPTA2IOT_MQTT_PASSWORD "mqtt_password"
 #define OPTA2IOT_MQTT_BASE "/opta/"
 #define OPTA2IOT_MQTT_INTERVAL 0
+#define OPTA2IOT_MQTT_BATCH 0 // Inputs publishing: 0=one topic per input, 1=one JSON message per poll, 2=one MessagePack message per poll
+#define OPTA2IOT_MQTT_RX_SIZE 1024 // no_config. In bytes, received MQTT messages with a larger payload are dropped
+#define OPTA2IOT_MQTT_RX_TIMEOUT 200 // no_config. In milliseconds, maximum delay for the end of a MQTT message payload split over network packets, read over next loops without blocking, uncomplete messages are dropped
+#define OPTA2IOT_MQTT_HANDLERS 8 // no_config. Number of MQTT topic patterns sketch can register with mqttOn()
+#define OPTA2IOT_MQTT_PATTERN_SIZE 128 // no_config. In bytes, maximum length of a registered MQTT topic pattern
 
 // Time
 #define OPTA2IOT_TIME_OFFSET 0
@@ -55,12 +60,25 @@
 // IO
 #define OPTA2IOT_IO_RESOLUTION 16 // no_config, analog resolution
 #define OPTA2IOT_IO_POLL 50   // no_config. In milliseconds, inputs poll loop delay
+#define OPTA2IOT_IO_DEADBAND 100 // In millivolts, minimum analog input change to publish a new value
+#define OPTA2IOT_IO_CAPTURE true // no_config. Capture digital and pulse inputs edges from interrupts instead of polling
+#define OPTA2IOT_IO_CAPTURE_SIZE 256 // no_config. Number of inputs edges kept between two polls, must be a power of 2
 
 // SERIAL
 #define OPTA2IOT_SERIAL_BAUDRATE 115200 // no_config, serial port speed (USB)
 
 // RS485
-#define OPTA2IOT_RS485_BAUDRATE 19200 // no_config, rs485 speed
+#define OPTA2IOT_RS485_BAUDRATE 19200 // RS485 and Modbus RTU speed
+#define OPTA2IOT_RS485_PARITY 1 // RS485 and Modbus RTU parity: 0=none (2 stop bits for Modbus), 1=even, 2=odd
+#define OPTA2IOT_RS485_BRIDGE false // Bridge RS485 to MQTT topics rs485/tx and rs485/rx
+#define OPTA2IOT_RS485_WINDOW 0 // In milliseconds, RS485 received frames within this delay are published to MQTT in one message, 0 to disable
+#define OPTA2IOT_RS485_BRIDGE_ROOM 256 // no_config. In bytes, MQTT messages are not read while RS485 send queue has less room
+#define OPTA2IOT_RS485_BRIDGE_HOLD 5000 // no_config. In milliseconds, maximum delay MQTT messages are not read for RS485 send queue
+#define OPTA2IOT_RS485_POLL 1 // no_config. In milliseconds, RS485 receive thread and loop delay, a bus silence is seen if longer than this delay
+#define OPTA2IOT_RS485_RX_SIZE 1024 // no_config. Size of RS485 received frames buffer in bytes
+#define OPTA2IOT_RS485_FRAMES 16 // no_config. Number of RS485 received frames waiting to be read, must be a power of 2
+#define OPTA2IOT_RS485_TX_SIZE 1024 // no_config. Size of RS485 messages waiting to be sent in bytes, must be a power of 2
+#define OPTA2IOT_RS485_TX_QUEUE 16 // no_config. Number of RS485 messages waiting to be sent, must be a power of 2
 
 // Modbus
 #define OPTA2IOT_MODBUS_TYPE 0 // This device modbus mode: 0=none, 1=RTU server, 2=TCP server, 3=RTU client, 4=TCP client
@@ -68,11 +86,53 @@
 #define OPTA2IOT_MODBUS_IP "0.0.0.0" // The modbus TCP server IP
 #define OPTA2IOT_MODBUS_PORT 502 // The modbus TCP server port
 #define OPTA2IOT_MODBUS_POLL 50 // no_config. In milliseconds, modbus server poll loop delay
+#define OPTA2IOT_MODBUS_REGISTERS 1024 // no_config. Maximum number of modbus server Holding and Input Registers
+#define OPTA2IOT_MODBUS_WRITE_TIMEOUT 5000 // no_config. In milliseconds, maximum delay for a master to complete Holding Registers update
+#define OPTA2IOT_MODBUS_TCP_POLL 5 // no_config. In milliseconds, modbus TCP server and modbus client poll loop delay
+#define OPTA2IOT_MODBUS_CACHE 512 // no_config. Number of values cached from modbus client scan list
+#define OPTA2IOT_MODBUS_RESPONSE_TIMEOUT 500 // no_config. In milliseconds, modbus client response timeout
+#define OPTA2IOT_MODBUS_RECONNECT 5000 // no_config. In milliseconds, delay between modbus client TCP connection attempts
+#define OPTA2IOT_MODBUS_CLIENTS 4 // no_config. Maximum number of concurrent modbus TCP masters
+#define OPTA2IOT_MODBUS_TIMEOUT 60000 // no_config. In milliseconds, modbus TCP master inactivity timeout
+#define OPTA2IOT_MODBUS_BURST 8 // no_config. Maximum number of pipelined requests answered per master on each modbus loop
 
 // Network
 #define OPTA2IOT_NETWORK_POLL 60  // no_config. In milliseconds, network client/server connection retry delay
 #define OPTA2IOT_NETWORK_TIMEOUT 5000 // no_config. In milliseconds, network/mqtt/... connection timeout
 
+// Journal
+#define OPTA2IOT_JOURNAL_SIZE 4096 // no_config. Number of inputs changes kept in flash while MQTT broker is not reachable, 0 to disable
+#define OPTA2IOT_JOURNAL_ADDRESS (14 * 1024 * 1024) // no_config. Flash address of journal raw region, between User partition and memory mapped WiFi firmware
+#define OPTA2IOT_JOURNAL_BUFFER 32 // no_config. Number of inputs changes kept in memory before writing them to flash
+#define OPTA2IOT_JOURNAL_FLUSH 10000 // no_config. In milliseconds, maximum delay before writing memory buffer to flash
+#define OPTA2IOT_JOURNAL_POLL 50 // no_config. In milliseconds, journal loop delay
+#define OPTA2IOT_JOURNAL_BURST 10 // no_config. Maximum number of journal records replayed on each journal loop
+
+// Loop
+#define OPTA2IOT_LOOP_SLEEP 10 // no_config. In milliseconds, maximum idle sleep between two loop passes, 0 to disable
+#define OPTA2IOT_SERIAL_POLL 20 // no_config. In milliseconds, serial commands poll loop delay
+#define OPTA2IOT_LED_POLL 50 // no_config. In milliseconds, LEDs update loop delay
+#define OPTA2IOT_BUTTON_POLL 10 // no_config. In milliseconds, button poll loop delay
+#define OPTA2IOT_LINK_POLL 250 // no_config. In milliseconds, network link check loop delay
+#define OPTA2IOT_TIME_POLL 1000 // no_config. In milliseconds, time update loop delay
+#define OPTA2IOT_MQTT_POLL 10 // no_config. In milliseconds, MQTT client poll loop delay
+#define OPTA2IOT_WEB_POLL 10 // no_config. In milliseconds, web server poll loop delay
+
+// Web server
+#define OPTA2IOT_WEB_CLIENTS 4 // no_config. Maximum number of concurrent web clients
+#define OPTA2IOT_WEB_TIMEOUT 5000 // no_config. In milliseconds, web client inactivity timeout
+#define OPTA2IOT_WEB_LINE 160 // no_config. In bytes, maximum length of a request line or header line, longer lines are truncated, must fit the longest Authorization header
+#define OPTA2IOT_WEB_FRAME 128 // no_config. In bytes, maximum length of a WebSocket frame from a client
+#define OPTA2IOT_WEB_BODY 2048 // no_config. In bytes, maximum length of a request body
+#define OPTA2IOT_WEB_BODY_TIMEOUT 10000 // no_config. In milliseconds, maximum duration to receive a whole request body
+#define OPTA2IOT_WEB_CHUNK 512 // no_config. In bytes, maximum data read or written for a web client on each web loop
+#define OPTA2IOT_WEB_EVENT 2560 // no_config. In bytes, maximum length of a live data event, larger events are not sent
+#define OPTA2IOT_WEB_EVENTS_PING 2000 // no_config. In milliseconds, delay between two live data events when nothing changes
+#define OPTA2IOT_WEB_CACHE 86400 // no_config. In seconds, browser cache duration of style and icon, pages are always revalidated
+
+// Profiler
+#define OPTA2IOT_PERF_PERCENTILE 99 // no_config. Percentile of loop tasks duration reported by profiler
+
 // Other
 #define OPTA2IOT_WATCHDOG_TIMEOUT 5000 // no_config. In milliseconds, freeze time before device reboot
 // Note: watchdog is set to max on somes task (for example on ethernet connection)
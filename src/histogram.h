@@ -0,0 +1,129 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_HISTOGRAM_H
+#define OPTA2IOT_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace opta2iot {
+
+/* Fixed size histogram.
+ *
+ * Values are stored in log2 buckets, each split into 4 linear sub buckets,
+ * so percentiles are known with an error below 25% whatever the range.
+ * Min, max and average are exact. No allocation, no dependency, it can run on host.
+ */
+class Histogram {
+
+public:
+
+  static const uint8_t BucketsMax = 92;  // up to 2^24 (about 16 seconds in microseconds)
+
+  void add(uint32_t value) {
+    _buckets[bucket(value)]++;
+    if (!_count || value < _min) {
+      _min = value;
+    }
+    if (value > _max) {
+      _max = value;
+    }
+    _sum += value;
+    _count++;
+  }
+
+  void reset() {
+    for (uint8_t i = 0; i < BucketsMax; i++) {
+      _buckets[i] = 0;
+    }
+    _count = _min = _max = 0;
+    _sum = 0;
+  }
+
+  uint32_t count() const {
+    return _count;
+  }
+
+  uint32_t min() const {
+    return _min;
+  }
+
+  uint32_t max() const {
+    return _max;
+  }
+
+  uint32_t average() const {
+    return _count ? (uint32_t)(_sum / _count) : 0;
+  }
+
+  // Get upper bound of the bucket holding the given percentile
+  uint32_t percentile(uint8_t percent) const {
+    if (!_count) {
+      return 0;
+    }
+    uint64_t rank = ((uint64_t)_count * percent + 99) / 100;
+    if (!rank) {
+      rank = 1;  // 0th percentile is the lowest value, not an empty bucket
+    }
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < BucketsMax; i++) {
+      seen += _buckets[i];
+      if (seen >= rank) {
+        uint32_t upper = i + 1 < BucketsMax ? lower(i + 1) - 1 : _max;
+
+        return upper < _max ? upper : _max;
+      }
+    }
+
+    return _max;
+  }
+
+  // Get bucket index of a value
+  static uint8_t bucket(uint32_t value) {
+    if (value < 4) {
+      return value;
+    }
+    uint8_t msb = 31;
+    while (!(value & (1UL << msb))) {
+      msb--;
+    }
+    uint16_t index = (msb - 1) * 4 + ((value >> (msb - 2)) & 3);
+
+    return index < BucketsMax ? index : BucketsMax - 1;
+  }
+
+  // Get lowest value of a bucket
+  static uint32_t lower(uint8_t index) {
+    if (index < 4) {
+      return index;
+    }
+
+    return (uint32_t)(4 + index % 4) << (index / 4 - 1);
+  }
+
+private:
+
+  uint32_t _buckets[BucketsMax] = { 0 };
+  uint32_t _count = 0;
+  uint32_t _min = 0;
+  uint32_t _max = 0;
+  uint64_t _sum = 0;
+
+};  // class Histogram
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_HISTOGRAM_H
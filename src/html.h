@@ -139,11 +139,17 @@ const char web_home_html[] = R"rawliteral(
       }
     });
 
-    async function updateStatus() {
+    // live data, each event has only what changed since previous one
+    const data = { inputs: {}, outputs: {} };
+
+    function updateStatus(event) {
       try {
-        const response = await fetch('/data');
-        const data = await response.json();
-        console.log(data.deviceId);
+        const changes = JSON.parse(event.data);
+        Object.assign(data.inputs, changes.inputs);
+        Object.assign(data.outputs, changes.outputs);
+        delete changes.inputs;
+        delete changes.outputs;
+        Object.assign(data, changes);
 
         document.title = "Opta " + data.deviceId;
         document.getElementById('title').innerText = "Opta " + data.deviceId;
@@ -193,6 +199,10 @@ const char web_home_html[] = R"rawliteral(
             li.appendChild(led);
             const val = data.outputs[pin] ? "ON" : "OFF";
             li.appendChild(document.createTextNode(`${val}`));
+            // switch output on click
+            li.style.cursor = 'pointer';
+            li.title = 'Switch output';
+            li.onclick = () => socket.send(JSON.stringify({ [pin]: data.outputs[pin] ? 0 : 1 }));
             outputList.appendChild(li);
         });
         
@@ -207,8 +217,14 @@ const char web_home_html[] = R"rawliteral(
       }
     }
 
-    setInterval(updateStatus, 2000);
-    window.onload = updateStatus;
+    // live data and outputs commands through WebSocket, reconnect on close
+    let socket;
+    function connect() {
+      socket = new WebSocket(`ws://${location.host}/ws`);
+      socket.onmessage = updateStatus;
+      socket.onclose = () => setTimeout(connect, 2000);
+    }
+    connect();
   </script>
 </body>
 
@@ -322,6 +338,16 @@ const char web_device_html[] = R"rawliteral(
         <input type="number" id="mqttInterval" name="mqttInterval" required>
         <p class="note">Set interval to 0 to disable the update.</p>
 
+        <div class="batch-toggle input-item">
+          <label for="mqttBatch">Inputs publishing:</label>
+          <div class="option-buttons">
+            <button type="button" class="option-button selected" data-input="mqttBatch" data-value="0">Topic per input</button>
+            <button type="button" class="option-button" data-input="mqttBatch" data-value="1">JSON</button>
+            <button type="button" class="option-button" data-input="mqttBatch" data-value="2">MessagePack</button>
+          </div>
+        </div>
+        <p class="note">JSON and MessagePack send all changed inputs in one message on topic inputs.</p>
+
     </div>
     
     <div class="box">
@@ -350,6 +376,31 @@ const char web_device_html[] = R"rawliteral(
         <input type="text" id="modbusPort" name="modbusPort" required>
         <p class="note">This is the port of the distant modbus TCP server.</p>
 
+        <label for="rs485Baudrate">RS485 baudrate:</label>
+        <input type="number" id="rs485Baudrate" name="rs485Baudrate" required>
+
+        <div class="parity-toggle input-item">
+          <label for="rs485Parity">RS485 parity:</label>
+          <div class="option-buttons">
+            <button type="button" class="option-button" data-input="rs485Parity" data-value="0">None</button>
+            <button type="button" class="option-button selected" data-input="rs485Parity" data-value="1">Even</button>
+            <button type="button" class="option-button" data-input="rs485Parity" data-value="2">Odd</button>
+          </div>
+        </div>
+        <p class="note">Used by RS485 and Modbus RTU, changes reboot device.</p>
+
+        <div class="bridge-toggle input-item">
+          <label for="rs485Bridge">RS485 MQTT bridge:</label>
+          <div class="option-buttons">
+            <button type="button" class="option-button" data-input="rs485Bridge" data-value="1">Enable</button>
+            <button type="button" class="option-button selected" data-input="rs485Bridge" data-value="0">Disable</button>
+          </div>
+        </div>
+
+        <label for="rs485Window">RS485 MQTT bridge window:</label>
+        <input type="number" id="rs485Window" name="rs485Window" required>
+        <p class="note">In milliseconds, RS485 frames received within this delay are published in one message.</p>
+
     </div>
 
 
@@ -430,6 +481,17 @@ const char web_device_html[] = R"rawliteral(
         document.getElementById('mqttPassword').value = data.mqttPassword;
         document.getElementById('mqttBase').value = data.mqttBase;
         document.getElementById('mqttInterval').value = data.mqttInterval;
+        if (data.mqttBatch !== undefined) {
+          const batchButtons = document.querySelectorAll('.batch-toggle .option-button');
+          batchButtons.forEach(button => {
+            const value = button.getAttribute('data-value');
+            if (value == data.mqttBatch) {
+              button.classList.add('selected');
+            } else {
+              button.classList.remove('selected');
+            }
+          });
+        }
 
         if (data.modbusType !== undefined) {
           const modbusButtons = document.querySelectorAll('.modbus-toggle .option-button');
@@ -445,6 +507,18 @@ const char web_device_html[] = R"rawliteral(
         document.getElementById('modbusId').value = data.modbusId;
         document.getElementById('modbusIp').value = data.modbusIp;
         document.getElementById('modbusPort').value = data.modbusPort;
+        document.getElementById('rs485Baudrate').value = data.rs485Baudrate;
+        document.getElementById('rs485Window').value = data.rs485Window;
+        if (data.rs485Bridge !== undefined) {
+          document.querySelectorAll('.bridge-toggle .option-button').forEach(button => {
+            button.classList.toggle('selected', button.getAttribute('data-value') == (data.rs485Bridge ? 1 : 0));
+          });
+        }
+        if (data.rs485Parity !== undefined) {
+          document.querySelectorAll('.parity-toggle .option-button').forEach(button => {
+            button.classList.toggle('selected', button.getAttribute('data-value') == data.rs485Parity);
+          });
+        }
         
         inputsContainer.innerHTML = ''; // Clear existing inputs
         for (const input in data.inputs) {
@@ -508,10 +582,15 @@ const char web_device_html[] = R"rawliteral(
         mqttPassword: formData.get('mqttPassword'),
         mqttBase: formData.get('mqttBase'),
         mqttInterval: parseInt(formData.get('mqttInterval'), 10),
+        mqttBatch: 0,
         modbusType: 0,
         modbusId: parseInt(formData.get('modbusId'), 10),
         modbusIp: formData.get('modbusIp'),
         modbusPort: formData.get('modbusPort'),
+        rs485Baudrate: parseInt(formData.get('rs485Baudrate'), 10),
+        rs485Parity: 1,
+        rs485Bridge: false,
+        rs485Window: parseInt(formData.get('rs485Window'), 10),
         inputs: {},
       };
 
@@ -532,6 +611,21 @@ const char web_device_html[] = R"rawliteral(
         config.netWifi = wifiButton.getAttribute('data-value') === '1';
       }
 
+      const batchButton = document.querySelector('.batch-toggle .option-button.selected');
+      if (batchButton) {
+        config.mqttBatch = parseInt(batchButton.getAttribute('data-value'), 10);
+      }
+
+      const parityButton = document.querySelector('.parity-toggle .option-button.selected');
+      if (parityButton) {
+        config.rs485Parity = parseInt(parityButton.getAttribute('data-value'), 10);
+      }
+
+      const bridgeButton = document.querySelector('.bridge-toggle .option-button.selected');
+      if (bridgeButton) {
+        config.rs485Bridge = bridgeButton.getAttribute('data-value') === '1';
+      }
+
       const modbusButton = document.querySelector('.modbus-toggle .option-button.selected');
       if (modbusButton) {
         config.modbusType = modbusButton.getAttribute('data-value');
@@ -545,7 +639,8 @@ const char web_device_html[] = R"rawliteral(
           body: JSON.stringify(config)
         });
         if (!response.ok) throw new Error('Failed to set configuration');
-        alert('Configuration updated successfully. Device is going to reboot');
+        const result = await response.json();
+        alert(result.message);
         window.location.href = "/";
       } catch (error) {
         alert(`Error: ${error.message}`);
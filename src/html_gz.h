@@ -0,0 +1,417 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+/**
+ * DO NOT EDIT, this file is generated from html.h by extras/html2gz.py
+ */
+
+#ifndef OPTA2IOT_HTML_GZ_H
+#define OPTA2IOT_HTML_GZ_H
+
+#include <stdint.h>
+
+namespace opta2iot {
+
+// web_home_html: 5196 bytes, 1607 bytes compressed
+constexpr uint8_t web_home_html_gz[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xCD, 0x58, 0xEB, 0x6F, 0xDB, 0x36,
+  0x10, 0xFF, 0x9E, 0xBF, 0xE2, 0x2A, 0x14, 0x93, 0x8C, 0x26, 0x52, 0x9A, 0x8F, 0x89, 0xED, 0xA1,
+  0xCD, 0xA3, 0xCB, 0xD0, 0xC6, 0x1D, 0xE2, 0x6D, 0x18, 0x86, 0x01, 0xA1, 0x25, 0xDA, 0x62, 0x43,
+  0x8B, 0x9A, 0x48, 0xD9, 0x35, 0x02, 0xFF, 0xEF, 0x3B, 0xBE, 0x6C, 0xDA, 0x8E, 0xD3, 0xB4, 0xC5,
+  0x80, 0xFA, 0x8B, 0x25, 0xF2, 0xEE, 0x77, 0x0F, 0xDE, 0x83, 0xA7, 0x83, 0xEE, 0x8B, 0x8B, 0xC1,
+  0xF9, 0xF0, 0xAF, 0x8F, 0x97, 0x50, 0xAA, 0x29, 0xEF, 0x1F, 0x74, 0xED, 0x1F, 0xFE, 0x53, 0x52,
+  0xF4, 0x0F, 0x00, 0xBA, 0x8A, 0x29, 0x4E, 0xFB, 0x6F, 0x9A, 0xA2, 0x65, 0x95, 0x80, 0x41, 0xAD,
+  0x48, 0x37, 0xB3, 0x6B, 0x7A, 0x97, 0xB3, 0xEA, 0x1E, 0x1A, 0xCA, 0x7B, 0x91, 0x54, 0x0B, 0x4E,
+  0x65, 0x49, 0xA9, 0x8A, 0xA0, 0x6C, 0xE8, 0xD8, 0xAD, 0xA4, 0xB9, 0x94, 0x11, 0xE2, 0x66, 0x16,
+  0xF0, 0xA0, 0x3B, 0x12, 0xC5, 0xC2, 0xB0, 0x16, 0x6C, 0x06, 0x39, 0x27, 0x52, 0xF6, 0xA2, 0x91,
+  0xF8, 0x1C, 0xE9, 0x35, 0x5C, 0x2D, 0x5F, 0x03, 0x2B, 0x7A, 0x91, 0x91, 0x10, 0x6D, 0x89, 0x2D,
+  0x5F, 0x3B, 0xA2, 0x96, 0xF7, 0x51, 0x72, 0xFF, 0x3D, 0x91, 0x0A, 0x85, 0x8F, 0x1B, 0x94, 0x0B,
+  0x44, 0x41, 0x57, 0xD6, 0xA4, 0x32, 0xEC, 0x05, 0x51, 0x74, 0xC8, 0xA6, 0x34, 0xF2, 0x12, 0xF4,
+  0x82, 0xD2, 0x0B, 0xFD, 0x6E, 0x86, 0x9C, 0xDD, 0x0C, 0x21, 0xB4, 0x12, 0x19, 0x6A, 0x81, 0x5A,
+  0xED, 0x57, 0xE7, 0xA4, 0xFF, 0xE1, 0xB7, 0xE1, 0x10, 0x65, 0x9F, 0x6C, 0xCA, 0x36, 0x2F, 0x00,
+  0xB7, 0x8A, 0xA8, 0x56, 0x9E, 0xAE, 0x25, 0x4F, 0xFF, 0x55, 0xCA, 0x2E, 0xAE, 0x64, 0x73, 0x5A,
+  0x00, 0x17, 0x73, 0x2D, 0x5A, 0x93, 0x79, 0xD6, 0x9F, 0xAA, 0x91, 0xAC, 0xCF, 0xDC, 0xCB, 0x26,
+  0xC0, 0x90, 0x7E, 0x56, 0x51, 0xFF, 0x82, 0xC9, 0x5C, 0x54, 0x15, 0xCD, 0x15, 0x2D, 0x42, 0xD6,
+  0x0D, 0x0B, 0xF0, 0x75, 0xD4, 0x2A, 0x25, 0xAA, 0x95, 0xF2, 0xE6, 0x2D, 0x32, 0x58, 0x75, 0x3B,
+  0xE2, 0x4C, 0x96, 0x37, 0x5A, 0xF8, 0x47, 0xFB, 0x0C, 0xF8, 0xD2, 0xCD, 0x2C, 0xD1, 0x73, 0x3D,
+  0x70, 0xC1, 0x26, 0x4C, 0x11, 0x0E, 0xD7, 0x55, 0xDD, 0x2A, 0x34, 0x36, 0x74, 0x86, 0x75, 0xB7,
+  0x25, 0xB0, 0xFB, 0xD1, 0x57, 0x79, 0xF7, 0x4D, 0x45, 0xB8, 0x98, 0xEC, 0x87, 0x26, 0x66, 0xFF,
+  0x5B, 0x90, 0x07, 0xAD, 0xDA, 0x83, 0x29, 0xEC, 0xCE, 0x57, 0xC0, 0x05, 0xAB, 0x63, 0x21, 0x14,
+  0x6D, 0x22, 0x7F, 0x8A, 0xDD, 0xBA, 0xDF, 0x25, 0x2E, 0xE0, 0xB3, 0x82, 0xCE, 0x58, 0xBE, 0x0E,
+  0x3A, 0x77, 0x30, 0xF6, 0xEF, 0x68, 0x44, 0xF2, 0xFB, 0xA8, 0x7F, 0x2E, 0xAA, 0x31, 0x9B, 0xB4,
+  0x0D, 0x05, 0x4B, 0xDC, 0xCD, 0x08, 0xAA, 0x51, 0x6F, 0xC2, 0x39, 0x7E, 0x74, 0x6A, 0xD9, 0x8E,
+  0x7C, 0x3A, 0x95, 0x4A, 0xD5, 0xF2, 0x34, 0xCB, 0xEC, 0x6A, 0x9A, 0x8B, 0x69, 0xF6, 0x29, 0x2F,
+  0x68, 0xC5, 0x64, 0x26, 0x30, 0x3D, 0x4E, 0x98, 0xC0, 0x98, 0xF1, 0x4F, 0x1A, 0x16, 0x8E, 0x82,
+  0xB0, 0x9A, 0xD1, 0x46, 0x32, 0x8C, 0x8B, 0xFE, 0xD1, 0x91, 0x8B, 0xA5, 0x95, 0x54, 0x67, 0x7D,
+  0xF0, 0xA0, 0x9F, 0x65, 0xDE, 0xB0, 0x5A, 0x59, 0x8A, 0x2C, 0xC3, 0x34, 0x23, 0xB9, 0x02, 0xB4,
+  0x66, 0x2C, 0x9A, 0x9C, 0x82, 0x8B, 0x2C, 0xB3, 0x8B, 0x41, 0x8A, 0x79, 0xE8, 0x56, 0xDE, 0x5A,
+  0x9B, 0x7B, 0x50, 0x88, 0xBC, 0x9D, 0xD2, 0x4A, 0xA5, 0x13, 0xAA, 0x2E, 0x39, 0xD5, 0x8F, 0x6F,
+  0x17, 0xD7, 0x45, 0x12, 0x06, 0x65, 0xC7, 0x86, 0xFF, 0x06, 0x6B, 0x4A, 0x8A, 0xE2, 0x72, 0x86,
+  0xD4, 0xEF, 0x99, 0x54, 0xB4, 0xA2, 0x4D, 0x12, 0xE7, 0x9C, 0xE5, 0xF7, 0xF1, 0x21, 0x10, 0xB9,
+  0xA8, 0x72, 0x48, 0x68, 0x07, 0x7A, 0x7D, 0x78, 0x70, 0x1E, 0xA3, 0x69, 0xDD, 0x50, 0x4D, 0x7F,
+  0x41, 0xC7, 0xA4, 0xE5, 0x2A, 0xE9, 0xF8, 0x9C, 0x52, 0xCD, 0x62, 0x45, 0xE5, 0xB5, 0xC4, 0x52,
+  0x51, 0xE3, 0x03, 0x45, 0x05, 0xC9, 0x9C, 0x30, 0x05, 0x63, 0xAA, 0xF2, 0x32, 0x89, 0x33, 0xA7,
+  0x03, 0x4A, 0x59, 0xB3, 0x00, 0x4C, 0xA9, 0x2A, 0x45, 0x71, 0x0A, 0xF1, 0xBB, 0xCB, 0x61, 0xBC,
+  0x5A, 0x5F, 0xAE, 0x44, 0x00, 0xB0, 0x31, 0x24, 0x2F, 0x3C, 0x6A, 0x2A, 0xEE, 0x3B, 0xA0, 0xCA,
+  0x46, 0xCC, 0xA1, 0xA2, 0x73, 0xB8, 0x6C, 0x1A, 0x81, 0xEA, 0x5F, 0x11, 0xA6, 0x4B, 0x80, 0x12,
+  0xDE, 0x50, 0xD0, 0x25, 0x25, 0x0E, 0x40, 0x08, 0xA7, 0x8D, 0x4A, 0x62, 0xBD, 0xEC, 0x69, 0x90,
+  0x41, 0xB6, 0x79, 0x4E, 0xA5, 0x1C, 0xB7, 0x9C, 0x2F, 0x5E, 0xAC, 0xC9, 0x97, 0x90, 0x13, 0xD4,
+  0x19, 0xFD, 0xA0, 0xE1, 0x3B, 0x81, 0xBE, 0x16, 0xE6, 0xCE, 0x88, 0x3D, 0x85, 0x97, 0x0F, 0x86,
+  0x20, 0x9D, 0x22, 0x06, 0x99, 0xD0, 0xE5, 0xDD, 0x1A, 0xE1, 0xC0, 0x5B, 0xE1, 0x4F, 0x97, 0xB3,
+  0x19, 0x06, 0x24, 0x51, 0xE4, 0x10, 0xF0, 0x9C, 0x4B, 0x30, 0x0E, 0x85, 0x92, 0x48, 0x3C, 0x71,
+  0xBE, 0x80, 0x79, 0x89, 0xD5, 0x35, 0x2F, 0x49, 0x35, 0xD1, 0x6A, 0xB1, 0x4A, 0x07, 0x00, 0x3A,
+  0x9D, 0x89, 0x56, 0x13, 0xD0, 0x20, 0x0A, 0x34, 0x06, 0xFA, 0xF6, 0x01, 0x98, 0x4D, 0x68, 0x78,
+  0x58, 0x1E, 0x82, 0xCB, 0x37, 0xFD, 0x02, 0x4B, 0x27, 0x74, 0xDC, 0x56, 0xB9, 0xC2, 0x80, 0x84,
+  0xB6, 0xD6, 0xB5, 0xD9, 0x96, 0xCC, 0xC4, 0xC8, 0x5D, 0x9B, 0xF4, 0xD8, 0x09, 0x5A, 0x35, 0x24,
+  0x0A, 0xF9, 0xF5, 0x76, 0x70, 0x93, 0xD6, 0xA4, 0x91, 0xD4, 0xF2, 0xA5, 0x5A, 0x78, 0xE0, 0xD5,
+  0xC1, 0xE8, 0x13, 0xD6, 0xCE, 0x14, 0x53, 0x89, 0x4D, 0xAA, 0x44, 0x6F, 0xA6, 0x56, 0xAB, 0x43,
+  0x0F, 0xE2, 0xDE, 0x9F, 0xE6, 0x71, 0xDA, 0xAF, 0x99, 0xDC, 0x42, 0xC0, 0x55, 0x50, 0x4E, 0x15,
+  0xDD, 0x42, 0xDD, 0xBB, 0xED, 0xF8, 0x9F, 0x12, 0xBA, 0x12, 0xE6, 0xCF, 0xC8, 0xC0, 0xF8, 0x8C,
+  0x32, 0xCD, 0x11, 0x1D, 0x10, 0xE9, 0xB6, 0x08, 0x11, 0xBC, 0x32, 0x6E, 0x4F, 0x6D, 0x41, 0xB9,
+  0x2E, 0xCE, 0x76, 0x39, 0xB6, 0x72, 0x30, 0x36, 0x08, 0x71, 0x07, 0x35, 0xC5, 0x04, 0xD3, 0xDD,
+  0xE6, 0xBB, 0xD0, 0x5C, 0x6D, 0xD9, 0xC6, 0xF3, 0xB5, 0x08, 0x66, 0x2B, 0x50, 0x47, 0xF9, 0x0C,
+  0x4C, 0xDF, 0xC1, 0xB7, 0x40, 0x0D, 0x8A, 0x6E, 0xE4, 0x88, 0x18, 0xC1, 0xBB, 0x0F, 0x43, 0xA3,
+  0xB0, 0x3D, 0xA8, 0xC9, 0x54, 0x41, 0x1F, 0x8E, 0xE1, 0x67, 0x88, 0x5E, 0x45, 0x70, 0x0A, 0x51,
+  0xD4, 0xF1, 0x72, 0x71, 0x2B, 0x70, 0x24, 0x06, 0xFC, 0xEF, 0x26, 0xEA, 0x4C, 0x22, 0x82, 0x6B,
+  0xB2, 0x3A, 0x18, 0xA5, 0x09, 0xC3, 0x2F, 0x6B, 0xB7, 0xEE, 0xF2, 0xA8, 0x9F, 0xA9, 0xD6, 0x37,
+  0x64, 0x4A, 0xBD, 0x7E, 0x7A, 0xF7, 0xDC, 0x77, 0x6E, 0x54, 0x27, 0xD6, 0xE9, 0x5F, 0xB2, 0x49,
+  0x19, 0xA3, 0x56, 0xB1, 0xBB, 0x0E, 0xC4, 0x67, 0xCF, 0x13, 0xA3, 0x0D, 0x7F, 0xCC, 0x09, 0x3B,
+  0x42, 0x56, 0x2F, 0x46, 0x4A, 0x78, 0x79, 0x88, 0x1F, 0xB5, 0xDD, 0x46, 0xE9, 0x56, 0x76, 0xB9,
+  0x4E, 0xAE, 0x6B, 0xEF, 0x13, 0x35, 0x3C, 0xDE, 0x68, 0xF8, 0x61, 0x25, 0xB3, 0x28, 0xB6, 0x69,
+  0x7F, 0x09, 0x24, 0x6C, 0xED, 0x21, 0x46, 0xA0, 0x83, 0x35, 0xFB, 0x97, 0xE1, 0x87, 0xF7, 0x08,
+  0x14, 0x07, 0x2E, 0x5B, 0x4B, 0xD8, 0x21, 0xD9, 0x4E, 0xAB, 0x7B, 0xBA, 0x90, 0x61, 0xF6, 0x77,
+  0x52, 0x6C, 0x61, 0x97, 0x58, 0xE5, 0x92, 0x9A, 0x55, 0x61, 0x27, 0xF1, 0xE5, 0x3C, 0xA0, 0xFD,
+  0x1B, 0x49, 0xFE, 0x49, 0xD5, 0xA2, 0xC6, 0xB3, 0xED, 0xC1, 0x31, 0x56, 0x26, 0xED, 0x40, 0x2B,
+  0x3C, 0xE0, 0xF2, 0x76, 0x73, 0x16, 0xDA, 0x9B, 0x63, 0xCF, 0x54, 0xD4, 0x99, 0x9C, 0xC4, 0x9C,
+  0x85, 0x46, 0xEA, 0x1F, 0x67, 0x1B, 0xC7, 0x7A, 0xF7, 0xF2, 0x01, 0xC5, 0x2D, 0x75, 0xE5, 0xDE,
+  0x51, 0x61, 0x46, 0x78, 0x4B, 0x53, 0x25, 0xAE, 0xD8, 0x67, 0x5A, 0x24, 0x27, 0x9D, 0x25, 0xFC,
+  0x71, 0xB7, 0x09, 0x16, 0x78, 0x84, 0xD4, 0x35, 0xAD, 0x8A, 0xF3, 0x92, 0xF1, 0x22, 0xE1, 0x6C,
+  0x43, 0xE8, 0x12, 0x28, 0xC7, 0xEE, 0x67, 0xCC, 0x60, 0xD2, 0xBB, 0x1A, 0x44, 0x83, 0x7D, 0x07,
+  0x37, 0xBE, 0xDF, 0x26, 0xC7, 0x84, 0x21, 0xB9, 0x9F, 0x4B, 0x5F, 0x3F, 0x76, 0x7C, 0x41, 0x8B,
+  0xDD, 0x44, 0xDA, 0xF1, 0xC0, 0x33, 0x92, 0xC9, 0x39, 0x36, 0xF4, 0xC1, 0x96, 0x1E, 0xDA, 0xDD,
+  0x37, 0xA2, 0xA0, 0x89, 0x73, 0xF8, 0x5D, 0xA7, 0xF3, 0x24, 0x3B, 0xCA, 0x78, 0xD4, 0x48, 0xD4,
+  0xE8, 0x29, 0x45, 0xA3, 0xC1, 0x8D, 0xA9, 0x42, 0x83, 0xAB, 0xAB, 0xE8, 0x5B, 0xD5, 0x43, 0xAC,
+  0x5D, 0xF5, 0xC2, 0xFC, 0x78, 0xEA, 0xA8, 0x37, 0xEE, 0x2B, 0x1B, 0x17, 0x96, 0x10, 0x21, 0xD7,
+  0xBC, 0xEE, 0x68, 0xCE, 0x45, 0x8B, 0x6D, 0xBF, 0xE7, 0x42, 0xFD, 0xD1, 0x84, 0xC4, 0x7E, 0x8B,
+  0x84, 0x8E, 0x3E, 0xB5, 0x23, 0x5E, 0xC1, 0x64, 0xCD, 0xC9, 0x42, 0xE7, 0x5F, 0x85, 0xD7, 0x81,
+  0xE0, 0x30, 0x7C, 0xB8, 0x7D, 0x0B, 0xD4, 0x88, 0x0B, 0xBC, 0xF5, 0x05, 0x58, 0x07, 0x5B, 0x55,
+  0xC6, 0xF6, 0xD1, 0x2F, 0x55, 0x19, 0xD7, 0x6D, 0xC3, 0x78, 0x5B, 0x33, 0xEE, 0xAD, 0x2F, 0x3B,
+  0xB5, 0xC3, 0x37, 0xFD, 0xA7, 0x8A, 0xC7, 0x8F, 0x90, 0x32, 0x4E, 0x4F, 0x13, 0x8A, 0x3F, 0x6A,
+  0xB6, 0x6C, 0xE9, 0xF8, 0xBF, 0x25, 0x0A, 0xD6, 0x38, 0x39, 0x67, 0xFA, 0xAE, 0x6C, 0x25, 0x82,
+  0x99, 0x92, 0x71, 0x96, 0xD8, 0x16, 0xE2, 0xBE, 0x54, 0xB4, 0x8D, 0xC4, 0x42, 0x88, 0x81, 0x50,
+  0x0B, 0x56, 0xE1, 0x90, 0xB7, 0xEB, 0x27, 0x7F, 0xF3, 0x8A, 0x6F, 0x43, 0xDC, 0x5D, 0x3A, 0x51,
+  0x19, 0x39, 0x48, 0x99, 0x98, 0x61, 0x45, 0x62, 0x28, 0x53, 0x8C, 0x71, 0x34, 0x25, 0x31, 0xD7,
+  0x56, 0xA9, 0x1A, 0x56, 0x4D, 0xD8, 0x78, 0x91, 0x3C, 0x80, 0xF1, 0xC3, 0xE9, 0xA3, 0xAE, 0x39,
+  0x46, 0xBF, 0xBC, 0xC6, 0xFC, 0xDD, 0x32, 0x2C, 0x08, 0xE0, 0xBD, 0x05, 0x20, 0x1C, 0x52, 0x36,
+  0x92, 0x3F, 0x68, 0x14, 0xCF, 0xC8, 0xFD, 0x80, 0xFA, 0x3B, 0x53, 0xFF, 0xF9, 0x48, 0x7B, 0x33,
+  0x7F, 0xFF, 0xE8, 0xA3, 0x63, 0x4C, 0x20, 0x0A, 0xB5, 0x23, 0x97, 0x19, 0x81, 0xEC, 0x68, 0x81,
+  0x6E, 0x76, 0xD7, 0xBA, 0x53, 0x1C, 0xEE, 0x2C, 0xE3, 0xD6, 0x20, 0xB4, 0x3B, 0x06, 0xA1, 0xB2,
+  0x85, 0x1F, 0x5B, 0x10, 0x7B, 0x3A, 0xC5, 0x77, 0x69, 0x26, 0xBB, 0x76, 0x52, 0xC2, 0x9F, 0x74,
+  0x74, 0x6B, 0x0E, 0xF4, 0x10, 0xE7, 0x49, 0x77, 0xCB, 0xB2, 0xB1, 0x25, 0x5C, 0x0B, 0xC5, 0xFB,
+  0xBE, 0x3B, 0xF3, 0xB3, 0xCD, 0x69, 0xC7, 0x51, 0x27, 0x6B, 0xDD, 0x2D, 0x19, 0x9A, 0xAD, 0x27,
+  0xC6, 0x15, 0x72, 0x72, 0x37, 0xD7, 0xB3, 0xFE, 0xCB, 0x07, 0x74, 0x05, 0xD1, 0x9C, 0x69, 0x29,
+  0xA4, 0x5A, 0x66, 0x73, 0xB9, 0x1E, 0xE3, 0x5C, 0x50, 0x89, 0xCA, 0x4D, 0x78, 0x88, 0x11, 0x0E,
+  0x53, 0x3B, 0x64, 0x46, 0xBD, 0x75, 0x48, 0x52, 0xA5, 0xEF, 0xD7, 0x68, 0x64, 0xE2, 0x94, 0x3A,
+  0x84, 0x93, 0xE3, 0xE3, 0x63, 0x07, 0xBF, 0xF4, 0x43, 0x9D, 0x55, 0xF7, 0xCC, 0x7C, 0x1E, 0xF0,
+  0xDF, 0x04, 0xBA, 0x99, 0xFD, 0x8A, 0xA7, 0x3F, 0xEB, 0x99, 0xEF, 0x85, 0x9A, 0xF6, 0x3F, 0x10,
+  0x10, 0xD2, 0x02, 0x4C, 0x14, 0x00, 0x00
+};
+constexpr char web_home_html_etag[] = "02d21010";
+
+// web_device_html: 18084 bytes, 3550 bytes compressed
+constexpr uint8_t web_device_html_gz[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xDD, 0x1C, 0x6B, 0x6F, 0xE3, 0x36,
+  0xF2, 0x7B, 0x7E, 0x05, 0xD7, 0x28, 0x6A, 0x07, 0x8D, 0xED, 0x64, 0xAF, 0x07, 0x1C, 0x1C, 0xDB,
+  0xC5, 0x6E, 0xBC, 0xBB, 0xCD, 0x61, 0x77, 0x93, 0x6B, 0xDC, 0x2B, 0x0E, 0x45, 0x81, 0xD0, 0x12,
+  0x6D, 0xB3, 0x91, 0x25, 0x55, 0xA2, 0x9C, 0xFA, 0xB6, 0xF9, 0xEF, 0x37, 0x7C, 0x48, 0x22, 0x69,
+  0x4A, 0x96, 0x92, 0x6D, 0xF6, 0xEE, 0x16, 0x8B, 0xC4, 0xA2, 0x38, 0xC3, 0x99, 0xE1, 0xCC, 0x70,
+  0x1E, 0x8C, 0x8F, 0xC6, 0x2F, 0x66, 0x57, 0x17, 0xF3, 0x7F, 0x5D, 0xBF, 0x41, 0x6B, 0xB6, 0x09,
+  0xA6, 0x47, 0x63, 0xF9, 0x0B, 0x7E, 0x13, 0xEC, 0x4F, 0x8F, 0x10, 0x1A, 0x33, 0xCA, 0x02, 0x32,
+  0x7D, 0x95, 0xF8, 0x19, 0x0D, 0x23, 0x74, 0x15, 0x33, 0x3C, 0x1E, 0xCA, 0x31, 0xFE, 0x36, 0xA0,
+  0xE1, 0x1D, 0x4A, 0x48, 0x30, 0xE9, 0xA4, 0x6C, 0x17, 0x90, 0x74, 0x4D, 0x08, 0xEB, 0xA0, 0x75,
+  0x42, 0x96, 0x6A, 0x64, 0xE0, 0xA5, 0x69, 0x07, 0xF0, 0x0E, 0x25, 0xC2, 0xA3, 0xF1, 0x22, 0xF2,
+  0x77, 0x02, 0x74, 0x19, 0x25, 0x1B, 0x44, 0xFD, 0x49, 0xC7, 0x8B, 0xC2, 0x25, 0x5D, 0xBD, 0x85,
+  0xC7, 0x0E, 0x7F, 0x01, 0xAF, 0x7C, 0xBA, 0x45, 0x5E, 0x80, 0xD3, 0x74, 0xD2, 0x59, 0x44, 0xBF,
+  0xAB, 0x51, 0x18, 0x5F, 0x9F, 0x09, 0x00, 0xB1, 0x7C, 0xC7, 0xA2, 0x69, 0x7D, 0xA6, 0x80, 0x87,
+  0x00, 0x2D, 0x3F, 0x1E, 0x40, 0xF6, 0x72, 0x3A, 0x23, 0x5B, 0xEA, 0x11, 0x80, 0x7D, 0x59, 0x8C,
+  0x06, 0x78, 0x41, 0x02, 0x04, 0xB4, 0x4D, 0x3A, 0xBE, 0x78, 0x7B, 0xE9, 0x77, 0xA6, 0x97, 0xFE,
+  0x68, 0x3C, 0x14, 0x6F, 0x8A, 0x79, 0x34, 0x8C, 0x33, 0x86, 0xD8, 0x2E, 0x26, 0x40, 0x0F, 0xF9,
+  0x1D, 0x98, 0xE6, 0x94, 0x15, 0x20, 0x28, 0xC4, 0x1B, 0xA2, 0x3F, 0x27, 0xE4, 0xB7, 0x8C, 0x26,
+  0xC4, 0x2F, 0x10, 0xC4, 0x39, 0x51, 0x61, 0xC4, 0x80, 0x99, 0xCB, 0x19, 0xDA, 0x64, 0x29, 0x43,
+  0xEF, 0xA3, 0xE8, 0x0E, 0x05, 0xF4, 0x8E, 0xA0, 0x53, 0xFE, 0x6F, 0x3C, 0x8C, 0x41, 0x68, 0x55,
+  0xB4, 0xFD, 0x98, 0x92, 0xA4, 0x33, 0x7D, 0x1F, 0xAD, 0x68, 0xD8, 0x8A, 0x40, 0x01, 0x67, 0x90,
+  0x28, 0x47, 0x4A, 0x22, 0x2B, 0x97, 0xBC, 0x06, 0x9A, 0xEF, 0xA3, 0x04, 0x84, 0x92, 0x7F, 0xAA,
+  0x5D, 0x39, 0xCE, 0xA7, 0x6B, 0xAB, 0x17, 0x28, 0x0C, 0x0A, 0x4A, 0xC4, 0x15, 0x12, 0x7A, 0x4B,
+  0x83, 0x00, 0xD1, 0x10, 0xB1, 0x35, 0x4D, 0xD1, 0x92, 0x92, 0xC0, 0x47, 0x51, 0x18, 0xEC, 0x10,
+  0x8B, 0x90, 0xB7, 0xC6, 0xE1, 0x8A, 0x20, 0x2F, 0x4B, 0x12, 0x12, 0x32, 0x94, 0x2F, 0x3A, 0xA8,
+  0x92, 0x1E, 0xA3, 0x1B, 0x72, 0xB5, 0x5C, 0xA6, 0xA0, 0xAB, 0xD3, 0x39, 0x7C, 0x46, 0x91, 0x78,
+  0xE0, 0xD8, 0xD7, 0x51, 0x96, 0xA4, 0xB5, 0x2C, 0x85, 0xD9, 0x66, 0xC1, 0x85, 0x25, 0x35, 0xB1,
+  0x40, 0xA4, 0x98, 0xD1, 0x47, 0x0E, 0xED, 0xF9, 0x9C, 0x73, 0x02, 0xFF, 0xD9, 0x9A, 0x20, 0xA6,
+  0x91, 0xB1, 0x4C, 0xA2, 0x0D, 0x7A, 0xF7, 0x61, 0x9E, 0xD3, 0x23, 0xF9, 0x68, 0xAB, 0xDC, 0x1F,
+  0x09, 0x03, 0x21, 0xDC, 0xE9, 0xDA, 0x6D, 0x4A, 0x21, 0x24, 0xEC, 0x32, 0xEE, 0x4C, 0x6F, 0x18,
+  0x66, 0xD4, 0x43, 0x97, 0xD7, 0x36, 0xD7, 0x95, 0x4A, 0x24, 0x01, 0x15, 0xC3, 0xEA, 0xC1, 0xE6,
+  0xD5, 0xC5, 0x2D, 0x41, 0x72, 0xAB, 0x61, 0xAD, 0xED, 0xB7, 0x08, 0xFB, 0x7E, 0x42, 0x52, 0x10,
+  0xC0, 0x12, 0xCD, 0xBE, 0xBF, 0xB8, 0x46, 0x9B, 0xC8, 0x27, 0x5C, 0x1A, 0x3E, 0x4D, 0xF1, 0x22,
+  0x20, 0xE6, 0xEE, 0xED, 0x51, 0xFE, 0x0E, 0x33, 0x72, 0x8F, 0x77, 0x9D, 0xA9, 0xFA, 0xD0, 0x86,
+  0xF8, 0x1C, 0xB6, 0xE4, 0xA0, 0x18, 0x69, 0xCF, 0xC6, 0x4A, 0x82, 0x3E, 0x92, 0x8D, 0x9B, 0x6C,
+  0x11, 0x72, 0x2D, 0x94, 0xBF, 0xD1, 0x06, 0xA7, 0x77, 0x6D, 0x38, 0x51, 0xE0, 0x25, 0x23, 0xF9,
+  0x40, 0x7B, 0x3E, 0xD2, 0x92, 0x82, 0x47, 0xF2, 0x32, 0x0B, 0xC1, 0xD3, 0xCF, 0x3E, 0xDE, 0x20,
+  0xF0, 0x25, 0x5B, 0x92, 0xB4, 0xE1, 0x83, 0x83, 0x96, 0x4C, 0x88, 0xA7, 0xF6, 0x1C, 0x94, 0x4B,
+  0xC3, 0x73, 0x63, 0x1E, 0x34, 0x0B, 0xF2, 0xD7, 0x5E, 0xDC, 0x67, 0xD1, 0x6A, 0x15, 0x00, 0x04,
+  0x27, 0xB5, 0x4F, 0x19, 0xD9, 0x74, 0x4A, 0x0A, 0xF6, 0x59, 0x06, 0x08, 0xE0, 0x19, 0xD6, 0xD9,
+  0xE7, 0xD6, 0xC4, 0x1D, 0xC5, 0x8C, 0x46, 0x61, 0x7F, 0x91, 0x31, 0x16, 0x71, 0x39, 0x69, 0xD3,
+  0x60, 0xA2, 0x1C, 0x56, 0x92, 0x91, 0x0F, 0x1D, 0x27, 0x64, 0x07, 0xF9, 0x98, 0xE1, 0xBE, 0xA0,
+  0xAE, 0xA4, 0x40, 0x0E, 0x6E, 0x71, 0x90, 0x01, 0xF8, 0x59, 0x67, 0xFA, 0x26, 0xE4, 0xAC, 0x8E,
+  0x87, 0x12, 0xE6, 0xB1, 0x6B, 0x81, 0x30, 0x03, 0xE2, 0x31, 0xE2, 0x37, 0x58, 0xF4, 0x14, 0xA4,
+  0x20, 0x05, 0xEC, 0x5A, 0x55, 0x73, 0x5B, 0xD6, 0x63, 0x1B, 0x87, 0xF6, 0x13, 0x5D, 0x52, 0xCB,
+  0x9B, 0x65, 0xA6, 0xBC, 0x03, 0x3A, 0xBD, 0xE2, 0x47, 0x02, 0x6C, 0x8F, 0x88, 0x0A, 0x10, 0x07,
+  0x41, 0x8B, 0x08, 0x8B, 0xB3, 0x00, 0xDE, 0x5A, 0x93, 0xA5, 0x9C, 0xE4, 0x2C, 0x1C, 0xFA, 0x28,
+  0x20, 0x78, 0x4B, 0xD0, 0xCD, 0x0D, 0x1C, 0xC6, 0x64, 0x13, 0x33, 0x71, 0xB6, 0x64, 0x29, 0x41,
+  0xAF, 0x3C, 0x8F, 0x7B, 0xAA, 0xEB, 0x88, 0xC2, 0xE9, 0xC2, 0x15, 0xCA, 0xC2, 0x36, 0x1E, 0xEA,
+  0x84, 0xD8, 0x26, 0x9E, 0x52, 0x38, 0xD4, 0x38, 0xD2, 0x56, 0x96, 0xCD, 0xA1, 0x34, 0xBB, 0x16,
+  0x48, 0xAA, 0x96, 0x38, 0x7C, 0x28, 0xD7, 0x1E, 0xCB, 0x3A, 0x86, 0x72, 0xC9, 0xBD, 0x03, 0xF9,
+  0xB3, 0x1F, 0xC9, 0xE6, 0x76, 0xDF, 0xC3, 0x2E, 0xB4, 0xB3, 0x3E, 0xBE, 0x6F, 0x1D, 0xA1, 0x16,
+  0x5F, 0xCA, 0xFA, 0x04, 0x05, 0xCF, 0x6D, 0x7D, 0xFB, 0x8B, 0x3E, 0x87, 0xF5, 0x7D, 0xF8, 0xC7,
+  0x7C, 0x2E, 0xAD, 0xCF, 0xA9, 0x85, 0x9B, 0xDF, 0x98, 0x8C, 0x26, 0xDA, 0xF9, 0x7E, 0x05, 0xA6,
+  0xB4, 0x2E, 0x7F, 0xDA, 0x8B, 0x43, 0xF7, 0xD7, 0xBA, 0x8E, 0x12, 0x38, 0x36, 0xF9, 0xCF, 0x56,
+  0x6B, 0x09, 0x30, 0x6D, 0x35, 0xF9, 0xDC, 0x60, 0x3D, 0x19, 0x6A, 0xF3, 0x9F, 0xAD, 0xD6, 0xD3,
+  0x23, 0xED, 0x12, 0x4D, 0x0D, 0x5B, 0x4F, 0xB3, 0x64, 0x03, 0x85, 0xCE, 0xE6, 0x73, 0xD8, 0xB2,
+  0xC5, 0xCA, 0x6B, 0x9C, 0x02, 0x5A, 0xFE, 0x13, 0x70, 0xC4, 0xD4, 0x6B, 0x25, 0x37, 0x01, 0xAC,
+  0x31, 0x20, 0x91, 0xD5, 0xA8, 0x5E, 0xC8, 0x40, 0xF1, 0x70, 0x00, 0x89, 0x14, 0xC7, 0x99, 0xA2,
+  0x2C, 0x06, 0x03, 0xE1, 0x8E, 0x44, 0x8E, 0x73, 0xCE, 0x52, 0x02, 0x99, 0xA6, 0x9F, 0x1E, 0xA0,
+  0x43, 0x0F, 0xEF, 0x0D, 0xCC, 0xBA, 0x8E, 0x16, 0x63, 0x87, 0xA3, 0x94, 0x1B, 0x91, 0x57, 0x28,
+  0x2A, 0x40, 0x98, 0xA7, 0xFC, 0x87, 0x0A, 0x46, 0x44, 0xE4, 0x2F, 0x29, 0xAD, 0x71, 0x8C, 0x0B,
+  0xCC, 0xBC, 0x75, 0x0B, 0xCF, 0x28, 0xE5, 0x05, 0x30, 0x85, 0x30, 0xE2, 0x6C, 0x11, 0xD0, 0x74,
+  0x4D, 0xC3, 0xD5, 0x33, 0x39, 0xCA, 0x0A, 0xE7, 0x55, 0x52, 0x66, 0xBB, 0xAF, 0x39, 0xD7, 0x10,
+  0x14, 0x43, 0xE8, 0x26, 0xA6, 0x3E, 0xD5, 0x79, 0x36, 0x5A, 0x16, 0x5C, 0xF5, 0xDF, 0x6F, 0xAE,
+  0x3E, 0x3E, 0xCB, 0x5A, 0x2F, 0x3B, 0xD3, 0x0F, 0x10, 0x42, 0xE0, 0x15, 0xE4, 0xB9, 0xDE, 0x5D,
+  0x3B, 0x2F, 0xED, 0xD2, 0x2A, 0x4E, 0xB8, 0x08, 0x59, 0x34, 0xAC, 0x20, 0x74, 0x18, 0xC0, 0x60,
+  0xC6, 0xD2, 0x60, 0x7D, 0x29, 0xCB, 0x94, 0xEB, 0x7E, 0x14, 0x12, 0xB4, 0x91, 0x53, 0x11, 0xE7,
+  0x4A, 0x88, 0x5B, 0xBE, 0xD6, 0x34, 0xAF, 0xD5, 0x79, 0x10, 0xF9, 0x8B, 0x2C, 0xB5, 0x4F, 0x04,
+  0x0D, 0x60, 0x23, 0x26, 0xD4, 0xEA, 0xAD, 0xA1, 0xB5, 0x62, 0xFA, 0x1C, 0xC4, 0x0D, 0xDA, 0x00,
+  0x3F, 0x9F, 0xA4, 0xA9, 0x4F, 0xD8, 0xBF, 0x92, 0x0C, 0x5B, 0x59, 0x7E, 0x98, 0xFF, 0xA8, 0xF2,
+  0x0B, 0xB7, 0xCA, 0x7C, 0xFE, 0x45, 0x41, 0x6B, 0xE6, 0x90, 0xC2, 0x3C, 0xEF, 0xA2, 0x7F, 0x91,
+  0x9C, 0x7A, 0x01, 0x05, 0x67, 0xFF, 0x5C, 0x8B, 0x7E, 0x2B, 0x39, 0xFD, 0x5C, 0x8B, 0x56, 0xF9,
+  0x9F, 0x8A, 0xD5, 0x1F, 0x13, 0x3F, 0xD5, 0x28, 0xB1, 0x28, 0x19, 0xCE, 0xDA, 0x9C, 0x33, 0x39,
+  0x58, 0x7E, 0xC6, 0x14, 0xCF, 0x4D, 0xB2, 0xE0, 0xB2, 0x88, 0x04, 0x79, 0x0B, 0x4F, 0x7D, 0xC4,
+  0x11, 0xAE, 0x32, 0x63, 0x9C, 0x22, 0x89, 0x0D, 0x95, 0xEA, 0x5B, 0x77, 0x70, 0xCB, 0x95, 0x21,
+  0x90, 0x6B, 0x51, 0x0F, 0x2A, 0x80, 0x4C, 0xF2, 0xE3, 0xD6, 0xE4, 0x5F, 0xA3, 0x68, 0x29, 0x3E,
+  0xC1, 0xF9, 0xC8, 0xB0, 0xCC, 0xB5, 0x38, 0xE9, 0xA5, 0x11, 0x1C, 0x24, 0xFD, 0x31, 0x71, 0x61,
+  0x09, 0x68, 0x30, 0x60, 0xC7, 0x86, 0x4D, 0x58, 0x88, 0x01, 0xE6, 0x29, 0x4C, 0x24, 0xE9, 0xB7,
+  0x7F, 0xFB, 0xEB, 0x6B, 0x9C, 0xF9, 0x09, 0xE6, 0xA8, 0x7F, 0xB8, 0x81, 0x47, 0xB4, 0x50, 0xCF,
+  0x2D, 0x34, 0xCA, 0xC4, 0xA3, 0xD8, 0xB2, 0x06, 0x5D, 0x51, 0xAF, 0xE6, 0x60, 0x63, 0x9C, 0x50,
+  0xB6, 0x6B, 0x11, 0x77, 0x08, 0xF4, 0xD7, 0x02, 0x2A, 0xA7, 0x5C, 0xE2, 0xF8, 0x22, 0xD9, 0x99,
+  0x4E, 0x8D, 0x6D, 0xEC, 0x1F, 0xE1, 0x38, 0xFC, 0x93, 0xF2, 0xB3, 0xCA, 0x65, 0x79, 0x62, 0xB8,
+  0x25, 0xE1, 0xE7, 0x8D, 0x36, 0x2A, 0x57, 0x83, 0x93, 0xE3, 0xCA, 0xF7, 0x9F, 0x1E, 0x67, 0x40,
+  0xBE, 0xE2, 0xA3, 0xC5, 0x0E, 0xC9, 0xED, 0x14, 0x01, 0x47, 0xE1, 0x4D, 0x4E, 0x54, 0x9C, 0x91,
+  0x82, 0x26, 0x2D, 0xA2, 0x88, 0x29, 0x97, 0x53, 0x17, 0xC9, 0x26, 0xD4, 0x5F, 0x91, 0xB6, 0x2A,
+  0xF5, 0x5A, 0x40, 0xE5, 0x2A, 0xC5, 0xF3, 0x50, 0x24, 0x11, 0x7D, 0x39, 0xBD, 0x52, 0x24, 0x3D,
+  0x6B, 0xE6, 0x5F, 0xB9, 0xF0, 0x67, 0x3B, 0xBD, 0xC4, 0x0A, 0x3F, 0xD1, 0xD0, 0x8F, 0xEE, 0x1D,
+  0xD2, 0x46, 0xF7, 0xE2, 0x4D, 0x5B, 0x27, 0xA4, 0xF0, 0xE9, 0x2E, 0x28, 0x1F, 0x3A, 0xEC, 0x5A,
+  0x2F, 0x43, 0xB4, 0x81, 0xBC, 0x94, 0xAA, 0xD4, 0xED, 0x44, 0xE9, 0xE1, 0x32, 0x01, 0x64, 0x5C,
+  0xED, 0x3C, 0x42, 0xB7, 0xA0, 0xA0, 0xF7, 0x14, 0x8E, 0xBC, 0x30, 0x3F, 0xF7, 0x02, 0xBC, 0x43,
+  0x38, 0x21, 0x79, 0xD6, 0x23, 0xE2, 0x60, 0x3D, 0x00, 0xDE, 0x0F, 0x78, 0x8F, 0x0E, 0x46, 0xBB,
+  0x32, 0x91, 0x32, 0x3A, 0x85, 0xDA, 0x6C, 0x19, 0x48, 0xF7, 0x81, 0x46, 0x86, 0x69, 0x28, 0x32,
+  0x7C, 0x53, 0xBE, 0x0A, 0xDE, 0x21, 0xBB, 0x17, 0xFD, 0x3E, 0x9A, 0xED, 0x40, 0x38, 0xD4, 0x83,
+  0xC8, 0x7D, 0x07, 0x07, 0x48, 0x9C, 0x05, 0xE0, 0x9E, 0x7D, 0x1E, 0x0B, 0x79, 0x77, 0x22, 0x4B,
+  0x14, 0x30, 0xA9, 0x38, 0xDA, 0x55, 0x44, 0xDF, 0xEF, 0x17, 0x64, 0xEC, 0x55, 0x73, 0x0E, 0xF2,
+  0x72, 0x83, 0xB7, 0x95, 0x3D, 0x4F, 0x95, 0xE3, 0xCB, 0x32, 0xC5, 0x85, 0x4A, 0xF8, 0x83, 0x16,
+  0x0D, 0x46, 0x1D, 0x81, 0xDA, 0x73, 0x63, 0xA8, 0xB6, 0xC5, 0xA8, 0x66, 0x96, 0xD5, 0x8A, 0x0B,
+  0xAB, 0xE4, 0xD0, 0xA2, 0xD7, 0x68, 0xE3, 0x32, 0x89, 0xD1, 0x0A, 0x22, 0x8E, 0xFD, 0x5C, 0x82,
+  0x37, 0x33, 0x77, 0x31, 0x9E, 0x9A, 0xF6, 0x9B, 0x66, 0x8B, 0x0D, 0x65, 0x85, 0xFD, 0x2A, 0x73,
+  0x16, 0xC9, 0xFE, 0x85, 0x68, 0x67, 0x67, 0x70, 0xC6, 0x82, 0x49, 0x17, 0x16, 0x59, 0xB4, 0xF0,
+  0x72, 0x74, 0x58, 0x75, 0xC9, 0x87, 0x16, 0x12, 0x24, 0x7F, 0xF5, 0x17, 0x90, 0xD1, 0xF1, 0xF2,
+  0x09, 0xE4, 0x75, 0x2C, 0x42, 0xBC, 0x49, 0xC7, 0xB3, 0x2D, 0xEC, 0x42, 0xA4, 0xE0, 0x57, 0x60,
+  0x05, 0xD9, 0x22, 0xEF, 0xBE, 0xAF, 0x19, 0x8B, 0xD3, 0xD1, 0x70, 0x28, 0x47, 0x07, 0x5E, 0xB4,
+  0x19, 0xFE, 0xEA, 0xF9, 0x24, 0xA4, 0xE9, 0x10, 0xBC, 0x0D, 0x7E, 0x49, 0x23, 0x88, 0x93, 0xF2,
+  0x4F, 0x1C, 0x31, 0xEA, 0xA3, 0x71, 0x1A, 0xE3, 0x50, 0x48, 0x0F, 0xA2, 0x94, 0x94, 0x72, 0x8E,
+  0xFA, 0xFD, 0xF1, 0x90, 0x8F, 0xEA, 0xEB, 0xBA, 0x2A, 0x88, 0xE3, 0x21, 0xEF, 0xE7, 0xF3, 0x4F,
+  0xFC, 0x21, 0xF5, 0x12, 0x1A, 0x33, 0x39, 0x05, 0xA7, 0xBB, 0xD0, 0x43, 0xCB, 0x2C, 0xF4, 0xB8,
+  0x40, 0xD0, 0x92, 0x40, 0x72, 0x2C, 0x65, 0xD4, 0x3B, 0x46, 0x9F, 0x14, 0x4A, 0x30, 0x9D, 0x94,
+  0x29, 0xED, 0xBE, 0xC8, 0xCD, 0x08, 0x4D, 0x90, 0x1F, 0x79, 0xD9, 0x06, 0xF6, 0x6B, 0xF0, 0x5B,
+  0x46, 0x92, 0xDD, 0x8D, 0x70, 0x8C, 0x51, 0xD2, 0xEB, 0x0E, 0x6C, 0x93, 0xEB, 0x1E, 0x9F, 0x2B,
+  0x54, 0x2C, 0xD9, 0x15, 0x68, 0x73, 0xC4, 0x09, 0x49, 0x63, 0xF8, 0x40, 0x00, 0x23, 0xBE, 0xC7,
+  0x94, 0x49, 0x2A, 0x7A, 0xDD, 0xA1, 0xBC, 0x7B, 0xD0, 0x3D, 0x41, 0x9F, 0xC0, 0x3B, 0xB0, 0x75,
+  0xE4, 0x8F, 0x50, 0xF7, 0xDD, 0x9B, 0x79, 0x17, 0x3D, 0x14, 0xF8, 0x10, 0x6F, 0x25, 0xF5, 0x5E,
+  0xE4, 0x28, 0x06, 0xD1, 0xDD, 0x31, 0x78, 0x9A, 0x24, 0xBA, 0x47, 0x21, 0xB9, 0x47, 0x6F, 0x92,
+  0x84, 0xD3, 0xF3, 0x16, 0xD3, 0x00, 0x6C, 0x16, 0x76, 0x4A, 0x60, 0x46, 0x9E, 0xAE, 0x04, 0x5D,
+  0x0D, 0x97, 0xA4, 0x87, 0xBB, 0xEF, 0x82, 0x96, 0x02, 0xF3, 0xAF, 0x69, 0x14, 0xF6, 0x60, 0x6E,
+  0x31, 0xB9, 0xE0, 0x5E, 0xDC, 0x78, 0x00, 0x80, 0x8E, 0xE8, 0x6A, 0x74, 0xD0, 0x37, 0x02, 0xC3,
+  0x20, 0xBF, 0x5E, 0x70, 0xBE, 0x0F, 0xB1, 0x22, 0xEC, 0x4D, 0x40, 0xF8, 0xC7, 0xD7, 0xBB, 0x4B,
+  0xBF, 0xD7, 0x15, 0x18, 0xBA, 0xC7, 0x20, 0x37, 0x10, 0xD6, 0x1C, 0xCC, 0xF5, 0x49, 0xD8, 0x94,
+  0x7A, 0xD8, 0xF8, 0xB6, 0x05, 0x2E, 0x35, 0xC1, 0xC5, 0x8B, 0x8D, 0x2B, 0x5F, 0x16, 0x90, 0x89,
+  0x03, 0x8D, 0xEF, 0x7A, 0x4B, 0x72, 0xCA, 0x3B, 0x0C, 0x6E, 0x24, 0xFC, 0x4D, 0x63, 0x34, 0xB9,
+  0x6B, 0x70, 0xA3, 0xCA, 0xDF, 0x36, 0x12, 0x79, 0x7E, 0x15, 0xC0, 0x46, 0x55, 0xBE, 0x69, 0x22,
+  0x20, 0xD1, 0x61, 0xB7, 0x51, 0x88, 0xC1, 0xF3, 0x46, 0xC0, 0xAA, 0xB9, 0xED, 0xC0, 0xA0, 0xDE,
+  0x34, 0x43, 0x23, 0x5B, 0xCB, 0x0E, 0x2C, 0xF2, 0x45, 0x33, 0x24, 0xB3, 0x30, 0x75, 0x60, 0x80,
+  0x51, 0xD3, 0xDA, 0x8A, 0x17, 0x6B, 0x2F, 0x46, 0x2F, 0x26, 0x13, 0x94, 0x85, 0x3E, 0x59, 0x82,
+  0x9D, 0xFB, 0xC7, 0x9A, 0x6D, 0x17, 0xD6, 0x04, 0xB3, 0x5E, 0xCB, 0x20, 0xAF, 0xD2, 0x65, 0xBC,
+  0x0A, 0x02, 0xF0, 0x1A, 0x7A, 0x87, 0x77, 0x60, 0x04, 0x5D, 0xBA, 0x8D, 0x22, 0x1D, 0xE3, 0x00,
+  0xFC, 0xDA, 0x1B, 0x0C, 0xCE, 0x42, 0xB9, 0xE7, 0xC9, 0xD4, 0xA0, 0x20, 0xA7, 0x21, 0x67, 0x49,
+  0xCE, 0xE2, 0xAC, 0xBF, 0x62, 0x2C, 0xA1, 0xF0, 0x48, 0x40, 0xB1, 0x8A, 0x68, 0xCD, 0x5C, 0x46,
+  0x32, 0xDB, 0x53, 0xB0, 0xC0, 0x66, 0xF7, 0xAC, 0x8B, 0xBE, 0xFE, 0x1A, 0xE9, 0xEC, 0x1F, 0xA3,
+  0x3F, 0xFE, 0x40, 0xFA, 0x94, 0x53, 0x31, 0xE5, 0x85, 0x31, 0xE7, 0xD8, 0xA2, 0x09, 0xE5, 0x74,
+  0x88, 0xA3, 0xE1, 0x3D, 0x24, 0xA2, 0x03, 0xEC, 0xC3, 0x0E, 0xE4, 0x91, 0xA5, 0x4D, 0xC6, 0x03,
+  0x82, 0x00, 0x83, 0x1C, 0x46, 0x92, 0x90, 0x4D, 0xB4, 0x25, 0x35, 0x78, 0xB4, 0x27, 0xDD, 0x83,
+  0x96, 0xE3, 0xCD, 0x54, 0x2D, 0xA5, 0xBE, 0x4B, 0xD1, 0x60, 0xB8, 0x99, 0x9A, 0x55, 0xD9, 0xB0,
+  0xF6, 0xCA, 0xAD, 0x70, 0xA2, 0x15, 0x7C, 0x50, 0xE1, 0x78, 0xAB, 0xB2, 0x99, 0xC2, 0xE9, 0x4D,
+  0xCD, 0x3A, 0x85, 0xD3, 0x30, 0x7E, 0x49, 0x85, 0xE3, 0xEC, 0x1F, 0x52, 0x38, 0x31, 0xE7, 0xFF,
+  0x49, 0xE1, 0x64, 0xD7, 0xD1, 0x56, 0x15, 0x39, 0x7A, 0xDE, 0x0C, 0x9C, 0x97, 0x8A, 0x5C, 0x08,
+  0xF8, 0x78, 0x43, 0x14, 0xAE, 0xD3, 0x2B, 0x1F, 0x6F, 0x4A, 0x45, 0x85, 0xD6, 0xEB, 0xEF, 0x1A,
+  0xA2, 0xE2, 0xFD, 0x36, 0x17, 0x1A, 0x3E, 0xDE, 0x10, 0x45, 0xDE, 0x24, 0x73, 0x0A, 0x56, 0xBD,
+  0x73, 0x18, 0x61, 0xD1, 0x40, 0x39, 0x6C, 0x86, 0xA2, 0x31, 0xD6, 0xCC, 0x0E, 0x8D, 0x1E, 0x5A,
+  0x9D, 0x21, 0xEA, 0x38, 0xFF, 0x7C, 0x4B, 0xCC, 0xAD, 0x0C, 0x99, 0xAC, 0xFF, 0xF7, 0x5B, 0x97,
+  0x63, 0xDF, 0x8A, 0xDA, 0xFA, 0xE1, 0x8D, 0x93, 0x73, 0x9B, 0xED, 0x9C, 0xD9, 0x46, 0xAA, 0xDB,
+  0x3A, 0x03, 0xEB, 0xB3, 0xEF, 0x5D, 0xC1, 0xFE, 0xFF, 0x8E, 0x6B, 0xAC, 0x36, 0x5F, 0xD5, 0x7F,
+  0xD8, 0x33, 0x5D, 0x35, 0x7E, 0xDE, 0x18, 0x45, 0x5C, 0x81, 0x22, 0x6E, 0x8C, 0xC2, 0xE9, 0x5A,
+  0x8B, 0x37, 0x0D, 0xD0, 0x18, 0x55, 0x6F, 0x1B, 0x93, 0xF1, 0xB2, 0x29, 0x32, 0x59, 0xBF, 0x72,
+  0xA2, 0x92, 0xAF, 0x1C, 0x6E, 0x4D, 0xAB, 0xDE, 0xD5, 0xD9, 0x47, 0xAD, 0x0F, 0x33, 0xAA, 0xA7,
+  0xB6, 0x25, 0x1C, 0x54, 0xF8, 0x3D, 0x05, 0x92, 0x88, 0x34, 0x05, 0x3A, 0x39, 0x6C, 0x06, 0x5C,
+  0xDF, 0xF7, 0x19, 0xFA, 0x0E, 0x9D, 0xA1, 0x11, 0x3A, 0x3D, 0x36, 0x34, 0xD0, 0xAD, 0x73, 0xA6,
+  0x40, 0x64, 0xE9, 0xFA, 0xB1, 0x02, 0x31, 0x3B, 0x14, 0x5F, 0x4E, 0x20, 0x36, 0x3F, 0x0D, 0xC4,
+  0x50, 0xCA, 0xC3, 0x2C, 0x79, 0xC8, 0x7C, 0xFA, 0xFB, 0xF9, 0x87, 0xF7, 0xA0, 0x56, 0xDD, 0xEE,
+  0x39, 0x1A, 0x0E, 0xD1, 0x45, 0x40, 0x70, 0x82, 0xC8, 0xEF, 0x40, 0x22, 0x0D, 0x57, 0x0A, 0xA2,
+  0x40, 0xC0, 0xAB, 0x82, 0x3D, 0xAD, 0x7C, 0xC2, 0x8B, 0x9D, 0x82, 0x20, 0x39, 0xCF, 0xE5, 0x7E,
+  0x69, 0x7A, 0x9D, 0x05, 0x69, 0xA1, 0xB8, 0x72, 0xE2, 0xCF, 0xE2, 0xD7, 0x2F, 0x9C, 0x9F, 0x97,
+  0xE7, 0x0E, 0x90, 0x19, 0x5D, 0x51, 0x86, 0x83, 0x4A, 0xA0, 0x33, 0x17, 0xD0, 0xAB, 0x10, 0x07,
+  0xD1, 0x0A, 0x60, 0x5E, 0x94, 0x08, 0x78, 0x2C, 0xA9, 0x28, 0x70, 0x80, 0x70, 0x7C, 0x97, 0x8C,
+  0x6C, 0xF4, 0x53, 0xC1, 0x4B, 0x08, 0x58, 0xA7, 0xB2, 0x43, 0x10, 0x3F, 0xDD, 0x9A, 0xBE, 0xAE,
+  0x00, 0x92, 0x7B, 0xF9, 0x11, 0x6F, 0x38, 0x6F, 0xDD, 0xB2, 0xBF, 0xD0, 0xD5, 0xD2, 0xEC, 0x7C,
+  0xA5, 0x98, 0x13, 0x20, 0x0F, 0x8B, 0x0B, 0x0E, 0x05, 0x10, 0xB9, 0x5C, 0xBE, 0x43, 0xA5, 0x0A,
+  0x80, 0x5E, 0xC3, 0x36, 0xEC, 0xA7, 0x9C, 0x92, 0x19, 0x1B, 0x3E, 0xE7, 0xB1, 0x01, 0x06, 0x2C,
+  0x44, 0x63, 0x23, 0x50, 0x02, 0x73, 0xC0, 0x3B, 0xF9, 0xD5, 0xB5, 0xE5, 0xD6, 0x6C, 0x37, 0x68,
+  0x65, 0xD5, 0xAF, 0x3E, 0x09, 0x88, 0x87, 0xCE, 0x34, 0xFF, 0xE4, 0xEA, 0x9C, 0xB4, 0xBA, 0x5E,
+  0xD1, 0xAA, 0x9F, 0xF1, 0xD5, 0x27, 0x5B, 0xD8, 0x0F, 0x66, 0x6B, 0xA3, 0x20, 0xD0, 0xEE, 0x61,
+  0x89, 0xFD, 0xA8, 0xBA, 0x0E, 0xD0, 0x92, 0x86, 0xFD, 0x2D, 0x6B, 0x44, 0xC5, 0x19, 0xEF, 0xAE,
+  0x08, 0xC8, 0xCF, 0x44, 0xC7, 0xDE, 0xC6, 0x37, 0x22, 0xE3, 0xB4, 0x33, 0x95, 0xBA, 0x51, 0xD1,
+  0x5D, 0x32, 0xBB, 0x3C, 0x08, 0xDD, 0xEE, 0x19, 0x88, 0xE6, 0x64, 0x70, 0x1C, 0x93, 0xD0, 0xBF,
+  0x58, 0xD3, 0xC0, 0xEF, 0x15, 0xCA, 0xE4, 0x8E, 0xEF, 0xEA, 0xFC, 0x6F, 0x3B, 0x87, 0xAB, 0x5C,
+  0x29, 0xC4, 0x3E, 0xBC, 0x0F, 0xCA, 0xB8, 0xC7, 0x25, 0x40, 0x4C, 0xAF, 0x2B, 0x1A, 0x1D, 0xE0,
+  0x6B, 0x8B, 0x12, 0x71, 0xEF, 0xD8, 0x19, 0xAB, 0x49, 0xF7, 0x56, 0x17, 0xAB, 0x89, 0x19, 0x76,
+  0x1C, 0xD4, 0x3A, 0xD0, 0x73, 0x1D, 0x12, 0x70, 0xD4, 0x00, 0xCD, 0xCA, 0x05, 0xED, 0xCB, 0xE2,
+  0xD6, 0x94, 0xC5, 0xCF, 0xCE, 0xFD, 0xFC, 0xE5, 0xB6, 0x14, 0x11, 0xC0, 0x6D, 0xB6, 0x5C, 0x42,
+  0xE8, 0x13, 0x12, 0x9F, 0xEB, 0x03, 0x3B, 0xE3, 0x14, 0x69, 0x1B, 0x52, 0x1A, 0x27, 0x50, 0xF1,
+  0xF9, 0x01, 0x79, 0x22, 0xCB, 0xEA, 0x11, 0x5E, 0xC1, 0x3E, 0xB6, 0x4A, 0xE6, 0x51, 0x40, 0x06,
+  0x44, 0x96, 0xB6, 0x45, 0x85, 0x5B, 0xDE, 0x52, 0xE4, 0xC7, 0x4F, 0x2A, 0x3A, 0x11, 0x23, 0xD8,
+  0x2F, 0x09, 0x58, 0xE0, 0x3B, 0xD2, 0x34, 0x47, 0xCA, 0x5C, 0xFC, 0x85, 0xDF, 0xA4, 0x3A, 0x98,
+  0x2A, 0xFF, 0xF0, 0x2F, 0x27, 0x98, 0x43, 0x38, 0x34, 0x44, 0x76, 0x5B, 0x60, 0x49, 0xD9, 0x4B,
+  0xE8, 0x41, 0x8C, 0xAD, 0x29, 0x17, 0x19, 0xC4, 0x09, 0xE1, 0x00, 0x33, 0xB2, 0xC4, 0x59, 0xC0,
+  0x7A, 0x05, 0x4D, 0x25, 0x19, 0x33, 0x59, 0x70, 0xE7, 0x15, 0xFB, 0xB7, 0xEA, 0xB1, 0xC7, 0xC7,
+  0xCB, 0xED, 0x86, 0x83, 0xF6, 0x3A, 0x21, 0x7C, 0x9F, 0xCD, 0xE2, 0x3D, 0x8A, 0x16, 0xBF, 0x82,
+  0x50, 0x0D, 0x8C, 0x72, 0x02, 0xE0, 0x2B, 0x85, 0x96, 0x57, 0xAB, 0x47, 0xC5, 0x72, 0x9C, 0x5D,
+  0xBD, 0xBA, 0x7D, 0x62, 0xCD, 0x15, 0x77, 0x89, 0x9D, 0xB3, 0x65, 0x29, 0xC0, 0x9E, 0x5F, 0x5C,
+  0x08, 0x76, 0xC2, 0x94, 0xB9, 0x7F, 0x09, 0x57, 0x96, 0x99, 0x47, 0xFC, 0x26, 0x46, 0x4A, 0x20,
+  0xED, 0xEE, 0x99, 0xC0, 0x7A, 0x8D, 0xFA, 0x04, 0x9D, 0x9D, 0x6A, 0xD0, 0xA2, 0xC2, 0x6C, 0x2F,
+  0xA6, 0x6A, 0xD1, 0xC6, 0xAC, 0xFC, 0x2F, 0xB0, 0xF6, 0xA7, 0x16, 0x95, 0x67, 0x63, 0xBE, 0xAC,
+  0x17, 0x3B, 0xA6, 0xE7, 0x15, 0x66, 0x63, 0xF6, 0x2C, 0x4C, 0x1D, 0x53, 0x45, 0x1D, 0xD9, 0x9C,
+  0xB7, 0xF6, 0x38, 0xB5, 0x18, 0x0E, 0x0C, 0x63, 0x5C, 0xFC, 0x79, 0x80, 0x63, 0x9C, 0x17, 0x13,
+  0x5D, 0x34, 0x88, 0xD2, 0xA3, 0x31, 0xB3, 0x4A, 0xF0, 0x46, 0x9D, 0xB1, 0x84, 0x90, 0x85, 0x23,
+  0x7B, 0x72, 0x5E, 0x64, 0x32, 0xE7, 0x89, 0x7B, 0x4A, 0x8E, 0x99, 0x32, 0xE9, 0x31, 0xE7, 0xBA,
+  0xF4, 0xA5, 0x2C, 0x1C, 0x59, 0x78, 0x2B, 0x48, 0x36, 0xAB, 0x44, 0x26, 0x0C, 0x2F, 0xED, 0xB8,
+  0xE6, 0xCB, 0x52, 0x90, 0xC5, 0x9F, 0xAA, 0xDF, 0x54, 0xEA, 0x95, 0x59, 0x00, 0xB2, 0x34, 0xAB,
+  0xA8, 0x73, 0x40, 0xCE, 0xA0, 0x8D, 0x16, 0x19, 0xB4, 0x63, 0x98, 0x1B, 0x56, 0xD5, 0x52, 0x45,
+  0xB2, 0x6A, 0x2F, 0xA3, 0x52, 0xCD, 0x3D, 0xA6, 0x8A, 0xD4, 0xD4, 0x9E, 0xEB, 0xDC, 0x0E, 0x2D,
+  0x0B, 0x2D, 0xE7, 0x1B, 0x79, 0x63, 0x25, 0x69, 0x56, 0xEA, 0x69, 0xD1, 0xA7, 0x65, 0x0C, 0x23,
+  0x74, 0x66, 0xE3, 0x96, 0x37, 0x5C, 0x6C, 0xC5, 0xD5, 0x92, 0xCC, 0xFA, 0x55, 0xF3, 0x1C, 0xD5,
+  0x5A, 0x53, 0x46, 0x02, 0x23, 0xF4, 0xE9, 0x21, 0x1F, 0x7B, 0x28, 0x3C, 0xA0, 0xDE, 0x83, 0x6D,
+  0x56, 0x9B, 0xB1, 0x9B, 0xB0, 0x56, 0x0E, 0x36, 0xD8, 0x3F, 0x8F, 0x0C, 0xEC, 0xB5, 0x01, 0x83,
+  0x46, 0x8D, 0x0A, 0xE8, 0x5B, 0x9C, 0xFB, 0x1A, 0xF0, 0x3F, 0xDB, 0x57, 0x78, 0xA4, 0x7B, 0x37,
+  0x52, 0x1C, 0x4E, 0xC2, 0x2F, 0x3C, 0x42, 0x2F, 0x50, 0x16, 0xE7, 0xDE, 0xB1, 0x25, 0xC0, 0xB2,
+  0x77, 0x54, 0xD7, 0xBF, 0xAE, 0xEE, 0x44, 0xB9, 0xA4, 0xC6, 0x93, 0xE6, 0x02, 0xAD, 0x75, 0x56,
+  0x73, 0x52, 0xF3, 0x56, 0xD9, 0x44, 0x5B, 0xBD, 0x3E, 0x69, 0x15, 0xA5, 0xFF, 0xF2, 0xEC, 0x3E,
+  0x72, 0xB7, 0x37, 0xEA, 0x38, 0xA8, 0x6E, 0x6D, 0x54, 0x70, 0x50, 0xA2, 0x75, 0x73, 0x20, 0x7A,
+  0x2F, 0x13, 0x6D, 0xF5, 0xC7, 0x73, 0xA0, 0x55, 0x71, 0xEB, 0x58, 0xA8, 0xA9, 0x0A, 0x57, 0xF0,
+  0xA0, 0x21, 0x76, 0x30, 0x51, 0xD6, 0xAE, 0x27, 0xA5, 0x71, 0x6A, 0x20, 0x35, 0x0C, 0x09, 0x3B,
+  0xAD, 0xE0, 0x46, 0xD6, 0x39, 0x0E, 0xB3, 0x53, 0x57, 0x0F, 0xA9, 0xE0, 0x47, 0x47, 0xED, 0x60,
+  0x48, 0x2F, 0xD2, 0x68, 0x2C, 0xE9, 0x50, 0x8F, 0xE4, 0x49, 0x16, 0xB3, 0x1A, 0x6C, 0x51, 0x4D,
+  0xD1, 0xAB, 0x6A, 0x8F, 0x34, 0xD4, 0x55, 0x3C, 0xA9, 0xC2, 0xD5, 0xC4, 0xA0, 0xE3, 0xF1, 0xFA,
+  0xA6, 0x97, 0x9E, 0xEB, 0xB8, 0xA9, 0x2B, 0x66, 0x57, 0x70, 0xA3, 0xA3, 0x76, 0xA9, 0x5C, 0x59,
+  0x76, 0x9F, 0x18, 0x64, 0x34, 0xF0, 0x74, 0x05, 0x13, 0xE6, 0x95, 0x99, 0x2D, 0x4E, 0x90, 0x97,
+  0x10, 0x1F, 0x18, 0xA0, 0x70, 0xFA, 0x70, 0x21, 0xB1, 0x08, 0x5B, 0x87, 0x8C, 0x76, 0xA9, 0x0B,
+  0xA4, 0xF3, 0x0D, 0xEA, 0x8C, 0xF8, 0xDD, 0x0F, 0xE7, 0x9C, 0x32, 0xE0, 0xD8, 0xF3, 0xD0, 0x95,
+  0xF7, 0x72, 0x38, 0x22, 0x7E, 0x2B, 0x47, 0x2F, 0xEF, 0xE7, 0xF7, 0x73, 0xAE, 0xAF, 0x6E, 0xE6,
+  0xDD, 0x13, 0xED, 0x0D, 0xFF, 0x6A, 0x11, 0x92, 0xF0, 0x53, 0x0D, 0x75, 0x5F, 0x65, 0x30, 0x2B,
+  0xA1, 0xFF, 0x96, 0x17, 0x6F, 0x46, 0xE8, 0x16, 0xC2, 0x17, 0xEA, 0x41, 0xDA, 0xAD, 0x71, 0xF4,
+  0x70, 0x7B, 0x82, 0xBA, 0x3C, 0x1B, 0x86, 0xE7, 0x3E, 0x17, 0x1D, 0xCC, 0xEB, 0x42, 0x4E, 0x0C,
+  0x79, 0xA8, 0x00, 0x1B, 0xF2, 0x8B, 0x38, 0x5D, 0xF4, 0xA0, 0xAF, 0xC1, 0xBF, 0xB6, 0x64, 0x84,
+  0xF8, 0x9F, 0xDD, 0x0C, 0x52, 0x10, 0x6A, 0xB8, 0xA2, 0xCB, 0x5D, 0x4F, 0xEE, 0xC1, 0xF1, 0x91,
+  0x2B, 0xD3, 0x6A, 0x75, 0x69, 0x88, 0x7F, 0xEB, 0xC3, 0x81, 0x2B, 0x43, 0x80, 0x0A, 0x72, 0x9B,
+  0xEA, 0x4B, 0x43, 0xF9, 0x6C, 0x1C, 0x90, 0x84, 0xF5, 0xE4, 0xEC, 0x81, 0xBA, 0xF1, 0xA8, 0xBD,
+  0x96, 0x97, 0x38, 0x07, 0x41, 0x24, 0x59, 0x1D, 0xF0, 0xCB, 0x62, 0xFC, 0xEA, 0xCE, 0xB0, 0x73,
+  0x38, 0x31, 0x94, 0xA8, 0x6F, 0x05, 0xF5, 0x23, 0x10, 0xA9, 0x98, 0x90, 0xAF, 0xF1, 0x70, 0x6B,
+  0xA7, 0x82, 0xF9, 0xC1, 0xA8, 0x96, 0x8C, 0xC2, 0x20, 0xC2, 0x3E, 0xAC, 0xA5, 0xDD, 0x00, 0x3B,
+  0x17, 0x37, 0xC7, 0xF2, 0xDB, 0x62, 0x47, 0xE3, 0xA1, 0xFC, 0x76, 0x18, 0xFE, 0x75, 0x31, 0xE2,
+  0x7B, 0x68, 0x38, 0xF8, 0x7F, 0x00, 0xD4, 0xC4, 0xCC, 0x8A, 0xA4, 0x46, 0x00, 0x00
+};
+constexpr char web_device_html_etag[] = "8accc4d4";
+
+// web_style_css: 2506 bytes, 743 bytes compressed
+constexpr uint8_t web_style_css_gz[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xCD, 0x56, 0xDB, 0x8E, 0x9B, 0x30,
+  0x10, 0x7D, 0xCF, 0x57, 0x58, 0xBB, 0xAA, 0xD4, 0x56, 0x01, 0x91, 0x6C, 0xB2, 0x17, 0x56, 0x7D,
+  0xE8, 0x77, 0x54, 0xFB, 0x60, 0x8C, 0x01, 0x77, 0x8D, 0x8D, 0x6C, 0x53, 0x92, 0x56, 0xFD, 0xF7,
+  0x8E, 0x2F, 0x2C, 0x24, 0x31, 0xAB, 0xDD, 0xAA, 0x0F, 0x85, 0x44, 0x09, 0xC3, 0xF1, 0xCC, 0x99,
+  0x33, 0x33, 0x86, 0x55, 0x21, 0xCB, 0x23, 0xFA, 0xB5, 0x42, 0xA8, 0x92, 0xC2, 0x24, 0x15, 0x6E,
+  0x19, 0x3F, 0xE6, 0xE8, 0xAB, 0x62, 0x98, 0xAF, 0x91, 0xC6, 0x42, 0x27, 0x9A, 0x2A, 0x56, 0x3D,
+  0x8E, 0x08, 0xCD, 0x7E, 0xD2, 0x1C, 0x6D, 0xD2, 0x1D, 0x6D, 0xAD, 0xAD, 0xC5, 0xAA, 0x66, 0x22,
+  0x47, 0x99, 0xBD, 0xE8, 0x70, 0x59, 0x32, 0x51, 0x87, 0xAB, 0x02, 0x93, 0xE7, 0x5A, 0xC9, 0x5E,
+  0x94, 0x09, 0x91, 0x5C, 0xAA, 0x1C, 0x5D, 0x57, 0x99, 0x3D, 0xED, 0xCD, 0xD1, 0x72, 0xEB, 0x8E,
+  0xC7, 0xD5, 0xEF, 0xD5, 0xEA, 0xB3, 0xA3, 0x51, 0xC8, 0x83, 0x8D, 0xE1, 0xDC, 0x14, 0x52, 0x95,
+  0x54, 0x25, 0x60, 0x72, 0x80, 0x14, 0xFE, 0x38, 0xCC, 0x18, 0x74, 0x9B, 0x75, 0x07, 0x84, 0x7B,
+  0x23, 0x4F, 0x82, 0x5B, 0xAB, 0xA7, 0x76, 0x48, 0x06, 0x56, 0x9A, 0x26, 0x47, 0xB7, 0x59, 0xB0,
+  0x4D, 0x9C, 0x2C, 0x9B, 0xCA, 0xA5, 0x15, 0xA2, 0x28, 0x5C, 0xB2, 0x5E, 0xE7, 0xE8, 0x3E, 0x20,
+  0x2D, 0x8F, 0x06, 0x97, 0x72, 0x80, 0x74, 0xD0, 0x16, 0x02, 0xED, 0xE0, 0xAB, 0xEA, 0x02, 0x7F,
+  0xCC, 0xD6, 0x28, 0x7C, 0xD2, 0xED, 0x27, 0xCF, 0x4C, 0x48, 0x43, 0x27, 0x15, 0xB5, 0x39, 0x72,
+  0x10, 0x89, 0x19, 0xCC, 0x19, 0x39, 0x53, 0x2E, 0x4B, 0xEF, 0xE7, 0xCA, 0x25, 0x46, 0x76, 0x39,
+  0x4A, 0x36, 0xDB, 0x91, 0xB3, 0x33, 0x16, 0xD2, 0x18, 0xD9, 0x82, 0xCC, 0xFB, 0xCE, 0xA7, 0xCE,
+  0x71, 0x41, 0xB9, 0x0B, 0x50, 0x32, 0xDD, 0x71, 0x0C, 0x25, 0x2A, 0xB8, 0x24, 0xCF, 0x91, 0x35,
+  0x7B, 0xEF, 0xC9, 0x85, 0x1C, 0x28, 0xAB, 0x1B, 0x63, 0x85, 0xE4, 0xA5, 0xF3, 0xC3, 0x44, 0xD7,
+  0x9B, 0x19, 0x51, 0x5F, 0x4C, 0x4B, 0x68, 0xBC, 0xF9, 0xCD, 0x1C, 0x3B, 0xFA, 0xE5, 0xCA, 0xD0,
+  0x83, 0xB9, 0x7A, 0x5A, 0x9F, 0xD8, 0x44, 0xDF, 0x16, 0x54, 0x9D, 0x5B, 0x3B, 0xAC, 0xF5, 0x00,
+  0x12, 0x5E, 0x3D, 0x39, 0xBF, 0x41, 0xF1, 0x4D, 0x96, 0x7D, 0x38, 0xA9, 0xCA, 0xFD, 0x2B, 0x09,
+  0x8E, 0x35, 0x80, 0x6B, 0xD0, 0x58, 0x4B, 0xCE, 0x4A, 0x74, 0x4D, 0x08, 0x89, 0x54, 0x67, 0xE7,
+  0x05, 0x29, 0x7A, 0x58, 0x2F, 0x02, 0x03, 0xDD, 0x17, 0x2D, 0x73, 0x6C, 0xBD, 0x39, 0xF5, 0x3F,
+  0x4B, 0x69, 0xA6, 0x8E, 0xBD, 0x86, 0xA6, 0x14, 0x06, 0x33, 0x41, 0xD5, 0xAC, 0xA7, 0x2E, 0x95,
+  0xF7, 0xE8, 0x84, 0x19, 0xDA, 0x46, 0x71, 0x59, 0x04, 0x37, 0x55, 0x2B, 0xA0, 0x95, 0x2F, 0xC3,
+  0x04, 0x9E, 0x31, 0x5C, 0x12, 0x6C, 0x13, 0x5A, 0xF6, 0x65, 0x76, 0x42, 0xB7, 0x5E, 0x4E, 0x55,
+  0x96, 0x3D, 0xEC, 0x08, 0x9D, 0xCB, 0x28, 0xA4, 0xA0, 0x4B, 0xE2, 0x81, 0xC7, 0x5E, 0x69, 0xBB,
+  0xB0, 0x93, 0x4C, 0x18, 0xAA, 0xAC, 0xC9, 0x96, 0x3B, 0x81, 0x6E, 0xAD, 0x61, 0xAA, 0x08, 0x1D,
+  0xAD, 0x8B, 0xB9, 0x7A, 0xFA, 0x79, 0x23, 0x7F, 0x04, 0xF5, 0x96, 0xA8, 0xC4, 0x38, 0x46, 0xB6,
+  0x85, 0x07, 0x7B, 0xCE, 0x5D, 0x27, 0x16, 0x15, 0x93, 0x27, 0x4E, 0x74, 0x71, 0x28, 0xDC, 0x74,
+  0x8D, 0x4A, 0xBA, 0xB5, 0x25, 0x25, 0x52, 0x61, 0xC3, 0x80, 0xFE, 0x24, 0xD3, 0x25, 0xA5, 0x5B,
+  0x72, 0xB7, 0xBF, 0xF3, 0x33, 0x93, 0xCA, 0xCE, 0xC2, 0x13, 0xCF, 0x4C, 0x9F, 0x4E, 0x61, 0xC5,
+  0xA9, 0xF3, 0xFD, 0xBD, 0xD7, 0x86, 0x55, 0x47, 0xD7, 0x54, 0x40, 0x2B, 0x47, 0xBA, 0xC3, 0x84,
+  0x26, 0x05, 0x35, 0x03, 0xA5, 0xC2, 0x22, 0x1C, 0x69, 0xD7, 0x1F, 0x7A, 0xA2, 0x7E, 0xE1, 0xDE,
+  0x79, 0x7F, 0xE9, 0x01, 0xBB, 0xE5, 0x8C, 0xEC, 0xCF, 0x3B, 0xF9, 0xBD, 0x43, 0x13, 0xAD, 0xFB,
+  0xAB, 0x7B, 0xF4, 0x52, 0xF3, 0x9E, 0x10, 0x4E, 0x35, 0xE5, 0x94, 0x18, 0x5A, 0xFA, 0xDD, 0xFB,
+  0xB5, 0xEE, 0x0C, 0x96, 0xA1, 0x01, 0x11, 0x22, 0x9E, 0xFE, 0x5D, 0x3B, 0x85, 0x0C, 0x22, 0xD3,
+  0x7B, 0x51, 0xB7, 0x68, 0x55, 0xDE, 0x3B, 0xE5, 0xD6, 0x19, 0x80, 0x1C, 0xA2, 0xD9, 0xAC, 0x51,
+  0xB3, 0x5D, 0xA3, 0xB4, 0x92, 0xF0, 0x4C, 0xF0, 0xE9, 0xC4, 0x9A, 0x16, 0xA0, 0x3D, 0xFF, 0x3F,
+  0x9F, 0x66, 0xC0, 0x8B, 0xB3, 0xBF, 0x91, 0x8B, 0xD3, 0xCA, 0x4C, 0xE3, 0x16, 0x1B, 0xC1, 0xA8,
+  0xAE, 0x53, 0x4C, 0x18, 0x1A, 0x31, 0xDF, 0x37, 0xA3, 0x0E, 0x2F, 0xFA, 0x91, 0x87, 0xE6, 0x0B,
+  0xF2, 0x8C, 0x8A, 0x35, 0xE1, 0xE1, 0x37, 0x5E, 0x9F, 0x29, 0xB3, 0xF7, 0x1B, 0xCA, 0x9B, 0x23,
+  0xF9, 0x32, 0x83, 0x8A, 0x8A, 0x89, 0x67, 0xF7, 0x8A, 0x63, 0x63, 0x37, 0x00, 0x59, 0xEA, 0xFC,
+  0x1D, 0xC1, 0xD5, 0x3E, 0xE0, 0xB8, 0x1C, 0x96, 0x60, 0xD5, 0x6E, 0x77, 0x73, 0xE3, 0x5F, 0x81,
+  0xD2, 0x9A, 0x99, 0xA6, 0x2F, 0x16, 0x66, 0x60, 0x61, 0xFF, 0x82, 0x85, 0x08, 0x8E, 0x3F, 0xA2,
+  0x0F, 0x81, 0x37, 0xCA, 0x09, 0x00, 0x00
+};
+constexpr char web_style_css_etag[] = "37810fa2";
+
+// web_favicon_hex: 6422 bytes
+constexpr char web_favicon_hex_etag[] = "f96576e9";
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_HTML_GZ_H
@@ -0,0 +1,289 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_HTTP_H
+#define OPTA2IOT_HTTP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+namespace opta2iot {
+
+/* Request body buffer shared by all web connections.
+ *
+ * Only one connection at a time owns it, from its first body byte until it releases it.
+ */
+template <size_t Size>
+class HttpBody {
+
+public:
+
+  char data[Size + 1];  // with null terminator
+
+  bool acquire(int id) {
+    if (_owner >= 0 && _owner != id) {
+      return false;
+    }
+    _owner = id;
+
+    return true;
+  }
+
+  void release(int id) {
+    if (_owner == id) {
+      _owner = -1;
+    }
+  }
+
+  static constexpr size_t capacity() {
+    return Size;
+  }
+
+private:
+
+  int _owner = -1;
+
+};  // class HttpBody
+
+/* Incremental HTTP request reader.
+ *
+ * Reads request line, headers and an optional body from any source with Arduino Client available() and read(),
+ * at most a given budget of bytes per call, so a slow client never holds the loop.
+ * Lines longer than the line buffer are truncated. No allocation, time is given by caller, so it can run on host.
+ */
+template <size_t LineSize>
+class HttpRequest {
+
+public:
+
+  enum Result {
+    HttpMore = 0,  // waiting for more data
+    HttpReady,     // request complete, with its body if any
+    HttpTooLarge,  // body larger than body buffer, answer 413
+    HttpBusy,      // body buffer used by another connection, answer 503
+    HttpTimeout    // body not received in time, answer 408
+  };
+
+  bool post = false;     // method is POST, else GET or unsupported
+  char path[24];         // request path without query string, empty if unsupported or too long
+  bool auth = false;     // Basic credentials match
+  bool gzip = false;     // client accepts gzip encoding
+  char match[24];        // client cached ETag
+  char key[32];          // client WebSocket key
+  char host[48];         // requested host, compared to WebSocket origin
+  char origin[64];       // page origin of a WebSocket request
+  bool upgrade = false;  // client asks for a WebSocket upgrade
+  uint8_t version = 0;   // client WebSocket version
+  uint32_t length = 0;   // request body length
+  uint32_t received = 0; // request body received length
+
+  // Reset for a new request, credentials is the expected base64 of user:password
+  void begin(const char *credentials, uint32_t bodyTimeout) {
+    _auth = credentials;
+    _bodyTimeout = bodyTimeout;
+    _state = StateRequest;
+    _lineLength = 0;
+    _consumed = 0;
+    post = auth = gzip = upgrade = false;
+    path[0] = match[0] = key[0] = host[0] = origin[0] = '\0';
+    version = 0;
+    length = received = 0;
+  }
+
+  // Read available bytes, at most budget, the body is read in shared body buffer
+  template <class Source, class Body>
+  Result read(Source &source, Body &body, int id, uint32_t now, size_t budget) {
+    if (_state == StateDone) {
+      return HttpReady;
+    }
+    if (_state == StateBody) {
+      return readBody(source, body, id, now, budget, nullptr, 0);
+    }
+
+    uint8_t buffer[64];
+    while (budget > 0 && source.available() > 0) {
+      int read = source.read(buffer, budget < sizeof(buffer) ? budget : sizeof(buffer));
+      if (read <= 0) {
+        break;
+      }
+      budget -= read;
+      _consumed += read;
+
+      for (int i = 0; i < read; i++) {
+        char c = buffer[i];
+        if (c == '\r') {
+          continue;
+        }
+        if (c != '\n') {
+          if (_lineLength < LineSize - 1) {
+            _line[_lineLength++] = c;
+          }
+          continue;
+        }
+        _line[_lineLength] = '\0';
+
+        if (_state == StateRequest) {
+          if (_lineLength > 0) {  // ignore empty lines before request
+            parseRequest();
+            _state = StateHeaders;
+          }
+        } else if (_lineLength > 0) {
+          parseHeader();
+        } else {
+          // end of headers, only authenticated posts have their body read
+          if (post && auth && length > 0) {
+            _state = StateBody;
+            _bodyTime = now;
+
+            return readBody(source, body, id, now, budget, buffer + i + 1, read - i - 1);
+          }
+          _state = StateDone;
+
+          return HttpReady;
+        }
+        _lineLength = 0;
+      }
+    }
+
+    return HttpMore;
+  }
+
+  // Total bytes read from source, to track client activity
+  size_t consumed() const {
+    return _consumed;
+  }
+
+private:
+
+  enum State {
+    StateRequest = 0,
+    StateHeaders,
+    StateBody,
+    StateDone
+  };
+
+  uint8_t _state = StateRequest;
+  char _line[LineSize];
+  size_t _lineLength = 0;
+  size_t _consumed = 0;
+  const char *_auth = nullptr;
+  uint32_t _bodyTimeout = 0;
+  uint32_t _bodyTime = 0;
+
+  template <class Source, class Body>
+  Result readBody(Source &source, Body &body, int id, uint32_t now, size_t budget, const uint8_t *data, size_t size) {
+    if (length > Body::capacity()) {
+      return HttpTooLarge;
+    }
+    if (!body.acquire(id)) {
+      return HttpBusy;
+    }
+
+    // bytes already read with headers
+    if (size > length - received) {
+      size = length - received;
+    }
+    if (size > 0) {
+      memcpy(body.data + received, data, size);
+      received += size;
+    }
+
+    while (budget > 0 && received < length && source.available() > 0) {
+      size = length - received;
+      if (size > budget) {
+        size = budget;
+      }
+      int read = source.read((uint8_t *)body.data + received, size);
+      if (read <= 0) {
+        break;
+      }
+      budget -= read;
+      received += read;
+      _consumed += read;
+    }
+
+    if (received >= length) {
+      body.data[length] = '\0';
+      _state = StateDone;
+
+      return HttpReady;
+    }
+    if (now - _bodyTime > _bodyTimeout) {
+      return HttpTimeout;
+    }
+
+    return HttpMore;
+  }
+
+  void parseRequest() {
+    // only request method and path are kept, query string is ignored
+    const char *start = nullptr;
+    if (strncmp(_line, "GET /", 5) == 0) {
+      start = _line + 4;
+    } else if (strncmp(_line, "POST /", 6) == 0) {
+      start = _line + 5;
+      post = true;
+    } else {
+      return;
+    }
+
+    size_t size = strcspn(start, " ?");
+    if (size < sizeof(path)) {
+      memcpy(path, start, size);
+      path[size] = '\0';
+    }
+  }
+
+  void parseHeader() {
+    if (strncasecmp(_line, "Authorization: Basic ", 21) == 0) {
+      auth = _auth != nullptr && strcmp(_line + 21, _auth) == 0;
+    } else if (strncasecmp(_line, "Content-Length:", 15) == 0) {
+      length = strtoul(_line + 15, nullptr, 10);
+    } else if (strncasecmp(_line, "Accept-Encoding:", 16) == 0) {
+      gzip = strstr(_line + 16, "gzip") != nullptr;
+    } else if (strncasecmp(_line, "If-None-Match:", 14) == 0) {
+      copy(14, match, sizeof(match));
+    } else if (strncasecmp(_line, "Sec-WebSocket-Key:", 18) == 0) {
+      copy(18, key, sizeof(key));
+    } else if (strncasecmp(_line, "Sec-WebSocket-Version:", 22) == 0) {
+      version = strtoul(_line + 22, nullptr, 10);
+    } else if (strncasecmp(_line, "Upgrade:", 8) == 0) {
+      char value[16];
+      copy(8, value, sizeof(value));
+      upgrade = strcasecmp(value, "websocket") == 0;
+    } else if (strncasecmp(_line, "Host:", 5) == 0) {
+      copy(5, host, sizeof(host));
+    } else if (strncasecmp(_line, "Origin:", 7) == 0) {
+      copy(7, origin, sizeof(origin));
+    }
+  }
+
+  void copy(size_t skip, char *target, size_t size) {
+    const char *value = _line + skip;
+    while (*value == ' ') {
+      value++;
+    }
+    strncpy(target, value, size - 1);
+    target[size - 1] = '\0';
+  }
+
+};  // class HttpRequest
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_HTTP_H
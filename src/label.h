@@ -23,6 +23,11 @@ const char label_main_reboot[] = "Rebooting device";
 const char label_main_thread[] = "Starting threaded loop";
 const char label_setup_end[] = "Setup completed \\o/";
 
+const char label_perf_setup[] = "Starting loop profiler";
+const char label_perf_none[] = "Loop profiler is not available";
+const char label_perf_print[] = "Loop tasks duration in microseconds (count / min / avg / max / percentile)";
+const char label_perf_reset[] = "Loop profiler reset";
+
 const char label_watchdog_start[] = "Starting watchdog";
 
 const char label_serial_setup[] = "\n+—————————————————————————————————————+\n| Arduino Opta Industrial IoT gateway |\n+—————————————————————————————————————+\n\n";
@@ -77,10 +82,13 @@ const char label_config_hold[] = "Hold for 5 seconds the user button to fully re
 const char label_config_json_read[] = "Reading configuration from JSON";
 const char label_config_json_read_error[] = "Failed to parse JSON";
 const char label_config_json_uncomplete[] = "Missing required keys in JSON";
+const char label_config_json_too_long[] = "Value too long in JSON for key ";
 const char label_config_default_read[] = "Loading default configuration";
 const char label_config_file_write[] = "Writing configuration to flash memory";
 const char label_config_file_read[] = "Reading configuration from flash memory";
 const char label_config_file_error[] = "Configuration file not found";
+const char label_config_file_migrate[] = "Migrating configuration from version ";
+const char label_config_file_legacy[] = "Importing configuration from previous JSON format";
 const char label_config_set_deviceid[] = "Set device id to: ";
 const char label_config_set_deviceuser[] = "Set device user to: ";
 const char label_config_set_devicepassword[] = "Set device password to: ";
@@ -99,17 +107,37 @@ const char label_config_set_mqttuser[] = "Set MQTT user: ";
 const char label_config_set_mqttpassword[] = "Set MQTT password: ";
 const char label_config_set_mqttbase[] = "Set MQTT base topic: ";
 const char label_config_set_mqttinterval[] = "Set MQTT interval: ";
+const char label_config_set_mqttbatch[] = "Set MQTT batch mode: ";
 const char label_config_set_modbustype[] = "Set Modbus mode: ";
 const char label_config_set_modbusid[] = "Set Modbus RTU device ID: ";
 const char label_config_set_modbusip[] = "Set Modbus TCP server IP: ";
 const char label_config_set_modbusport[] = "Set Modbus TCP server port: ";
+const char label_config_set_modbusscan[] = "Add Modbus scan list entry: ";
+const char label_config_set_rs485baudrate[] = "Set RS485 baudrate: ";
+const char label_config_set_rs485parity[] = "Set RS485 parity: ";
+const char label_config_set_rs485bridge[] = "Set RS485 MQTT bridge: ";
+const char label_config_set_rs485window[] = "Set RS485 MQTT bridge window: ";
+const char label_config_hot[] = "Applying configuration without reboot";
+
+const char label_journal_setup[] = "Configuring MQTT journal";
+const char label_journal_none[] = "MQTT journal is disabled";
+const char label_journal_device_error[] = "Journal flash region is not usable";
+const char label_journal_skip[] = "Skipping uncleared journal flash sector";
+const char label_journal_pending[] = "Journal records waiting for broker: ";
+const char label_journal_write_error[] = "Failed to write journal to flash";
+const char label_journal_replayed[] = "Journal replayed to MQTT broker";
+const char label_journal_lost[] = "Journal records lost or unreadable: ";
 
 const char label_io_setup[] = "Configuring IO";
 const char label_io_resolution[] = "Set IO resolution to: ";
+const char label_io_capture[] = "Capture edges from interrupt on input ";
 //...
 
 const char label_rs485_setup[] = "Configuring RS485";
 const char label_rs485_none[] = "RS485 is disabled";
+const char label_rs485_bridge_drop[] = "RS485 send queue is full, dropping MQTT message";
+const char label_rs485_framing[] = "Set RS485 framing: ";
+const char label_rs485_timing[] = "RS485 character time, t1.5, t3.5 in microseconds: ";
 
 const char label_modbus_setup[] = "Configuring Modbus";
 const char label_modbus_none[] = "Modbus is disabled";
@@ -120,6 +148,19 @@ const char label_modbus_tcp[] = "Using TCP";
 const char label_modbus_start_error[] = "Failed to start Modbus";
 const char label_modbus_registers_size[] = "Size of modbus Holdings Registers: ";
 const char label_modbus_registers_change[] = "Modbus Holding Registers change";
+const char label_modbus_registers_part[] = "Applying Modbus Holding Registers part: ";
+const char label_modbus_registers_invalid[] = "Invalid Modbus Holding Registers part: ";
+const char label_modbus_registers_timeout[] = "Uncompleted Modbus Holding Registers update, restoring registers";
+const char label_modbus_command_reboot[] = "Modbus reboot command received";
+const char label_modbus_command_reset[] = "Modbus reset command received";
+const char label_modbus_command_time[] = "Modbus time update command received";
+const char label_modbus_tcp_port[] = "Listening Modbus TCP masters on port: ";
+const char label_modbus_tcp_accept[] = "Modbus TCP master connected: ";
+const char label_modbus_tcp_connect[] = "Connecting Modbus TCP server: ";
+const char label_modbus_scan[] = "Modbus scan list requests: ";
+const char label_modbus_scan_full[] = "Modbus scan list cache is full, ignoring entries";
+const char label_modbus_scan_timeout[] = "Modbus response timeout from server: ";
+const char label_modbus_scan_error[] = "Modbus error response from server: ";
 
 const char label_network_setup[] = "Configuring network";
 const char label_network_mode[] = "Set network mode as: ";
@@ -153,10 +194,15 @@ const char label_mqtt_server[] = "Using broker: ";
 const char label_mqtt_broker[] = "Connecting to MQTT broker";
 const char label_mqtt_broker_fail[] = "Failed to connect to MQTT broker";
 const char label_mqtt_broker_success[] = "MQTT broker found";
+const char label_mqtt_broker_lost[] = "MQTT broker connection lost";
+const char label_mqtt_restart[] = "Restarting MQTT connection with new configuration";
 const char label_mqtt_subscribe[] = "Subcribed to MQTT topic: ";
 const char label_mqtt_receive[] = "Receiving MQTT command: ";
+const char label_mqtt_receive_drop[] = "MQTT message is too large, dropping: ";
+const char label_mqtt_receive_partial[] = "MQTT message is uncomplete, dropping: ";
 const char label_mqtt_publish_device[] = "Publishing device informations to MQTT";
 const char label_mqtt_publish_inputs[] = "Publishing inputs informations to MQTT";
+const char label_mqtt_publish_perf[] = "Publishing loop profiler to MQTT";
 
 const char label_web_setup[] = "Configuring web server";
 const char label_web_ethernet[] = "Creating Ethernet Web server";
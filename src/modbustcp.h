@@ -0,0 +1,173 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_MODBUSTCP_H
+#define OPTA2IOT_MODBUSTCP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace opta2iot {
+
+/* Modbus TCP server protocol.
+ *
+ * MBAP framing of pipelined requests and answers to function codes 1 to 6, 15 and 16.
+ * Values are read and written through a Tables object with ArduinoModbus server like methods
+ * (coilRead(), holdingRegisterWrite()...) and tables sizes (coilsNum(), inputRegistersNum()...),
+ * so device serves its server tables and host tests a fake one. No allocation, no dependency.
+ */
+class ModbusTcp {
+
+public:
+
+  static constexpr size_t AduMax = 260;
+
+  // Get length of first request in buffer, 0 if not complete yet, -1 if not Modbus protocol
+  static int frame(const uint8_t *buffer, size_t length) {
+    if (length < 8) {
+      return 0;
+    }
+    size_t size = 6 + ((buffer[4] << 8) | buffer[5]);  // MBAP header + unit + PDU
+    if (buffer[2] != 0 || buffer[3] != 0 || size < 8 || size > AduMax) {
+      return -1;
+    }
+
+    return length < size ? 0 : size;
+  }
+
+  // Build response of a whole request, response must hold AduMax bytes, get response length
+  template <class Tables>
+  static size_t respond(Tables &tables, const uint8_t *request, size_t length, uint8_t *response) {
+    const uint8_t *pdu = request + 7;
+    const size_t pduLength = length - 7;
+    const uint8_t function = pdu[0];
+    const uint16_t address = pduLength >= 5 ? (pdu[1] << 8) | pdu[2] : 0;
+    const uint16_t count = pduLength >= 5 ? (pdu[3] << 8) | pdu[4] : 0;
+
+    memcpy(response, request, 7);  // same transaction, protocol and unit
+    uint8_t *out = response + 7;
+    size_t outLength = 0;
+    uint8_t exception = 0;
+
+    switch (function) {
+      case 0x01:  // read coils
+      case 0x02:  // read discrete inputs
+        if (pduLength != 5 || count < 1 || count > 2000) {
+          exception = 3;
+        } else if ((size_t)address + count > (function == 0x01 ? tables.coilsNum() : tables.discreteInputsNum())) {
+          exception = 2;
+        } else {
+          out[1] = (count + 7) / 8;
+          memset(out + 2, 0, out[1]);
+          for (size_t i = 0; i < count; i++) {
+            if ((function == 0x01 ? tables.coilRead(address + i) : tables.discreteInputRead(address + i)) > 0) {
+              out[2 + i / 8] |= 1 << (i % 8);
+            }
+          }
+          outLength = 2 + out[1];
+        }
+        break;
+
+      case 0x03:  // read holding registers
+      case 0x04:  // read input registers
+        if (pduLength != 5 || count < 1 || count > 125) {
+          exception = 3;
+        } else if ((size_t)address + count > (function == 0x03 ? tables.holdingRegistersNum() : tables.inputRegistersNum())) {
+          exception = 2;
+        } else {
+          out[1] = count * 2;
+          for (size_t i = 0; i < count; i++) {
+            long value = function == 0x03 ? tables.holdingRegisterRead(address + i) : tables.inputRegisterRead(address + i);
+            out[2 + i * 2] = value >> 8;
+            out[3 + i * 2] = value & 0xFF;
+          }
+          outLength = 2 + out[1];
+        }
+        break;
+
+      case 0x05:  // write single coil
+        if (pduLength != 5 || (count != 0xFF00 && count != 0)) {
+          exception = 3;
+        } else if (address >= tables.coilsNum()) {
+          exception = 2;
+        } else {
+          tables.coilWrite(address, count ? 1 : 0);
+          memcpy(out, pdu, 5);
+          outLength = 5;
+        }
+        break;
+
+      case 0x06:  // write single register
+        if (pduLength != 5) {
+          exception = 3;
+        } else if (address >= tables.holdingRegistersNum()) {
+          exception = 2;
+        } else {
+          tables.holdingRegisterWrite(address, count);
+          memcpy(out, pdu, 5);
+          outLength = 5;
+        }
+        break;
+
+      case 0x0F:  // write multiple coils
+        if (pduLength < 6 || count < 1 || count > 1968 || pdu[5] != (count + 7) / 8 || pduLength != 6u + pdu[5]) {
+          exception = 3;
+        } else if ((size_t)address + count > tables.coilsNum()) {
+          exception = 2;
+        } else {
+          for (size_t i = 0; i < count; i++) {
+            tables.coilWrite(address + i, (pdu[6 + i / 8] >> (i % 8)) & 1);
+          }
+          memcpy(out, pdu, 5);
+          outLength = 5;
+        }
+        break;
+
+      case 0x10:  // write multiple registers
+        if (pduLength < 6 || count < 1 || count > 123 || pdu[5] != count * 2 || pduLength != 6u + pdu[5]) {
+          exception = 3;
+        } else if ((size_t)address + count > tables.holdingRegistersNum()) {
+          exception = 2;
+        } else {
+          for (size_t i = 0; i < count; i++) {
+            tables.holdingRegisterWrite(address + i, (pdu[6 + i * 2] << 8) | pdu[7 + i * 2]);
+          }
+          memcpy(out, pdu, 5);
+          outLength = 5;
+        }
+        break;
+
+      default:
+        exception = 1;
+    }
+
+    if (exception) {
+      out[1] = exception;
+      outLength = 2;
+    }
+    out[0] = exception ? function | 0x80 : function;
+
+    response[4] = (outLength + 1) >> 8;
+    response[5] = (outLength + 1) & 0xFF;
+
+    return 7 + outLength;
+  }
+
+};  // class ModbusTcp
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_MODBUSTCP_H
@@ -26,10 +26,12 @@
 #include <NTPClient.h>
 #include <mbed_mktime.h>
 #include <base64.hpp>
+#include <mbedtls/sha1.h>
 #include "define.h"
 #include "opta2iot.h"
 #include "label.h"
 #include "html.h"
+#include "html_gz.h"
 #include "certificates.h"
 
 // Opta board info
@@ -40,6 +42,7 @@ OptaBoardInfo *boardInfo();
 #include "BlockDevice.h"
 #include "MBRBlockDevice.h"
 #include "FATFileSystem.h"
+#include "SlicingBlockDevice.h"
 const uint32_t file_size = 421098;
 extern const unsigned char wifi_firmware_image_data[];
 
@@ -79,11 +82,13 @@ bool Opta::setup() {
 
   return watchdogSetup()
          && serialSetup()
+         && perfSetup()
          && boardSetup()
          && flashSetup()
          && ledSetup()
          && buttonSetup()
          && configSetup()
+         && journalSetup()
          && ioSetup()
          && networkSetup()
          && timeSetup()
@@ -95,16 +100,124 @@ bool Opta::setup() {
 }
 
 bool Opta::loop() {
-  return startLoop()
-         && serialLoop()
-         && ledLoop()
-         && buttonLoop()
-         && ioLoop()
-         && networkLoop()
-         && timeLoop()
-         && modbusLoop()
-         && mqttLoop()
-         && webLoop();
+  if (!startLoop()) {
+    return false;
+  }
+
+  if (!_loopScheduler.size()) {
+    loopSchedule();
+  }
+
+  // always run the highest priority due task first, IO is never delayed by more than one lower task
+  int task;
+  while ((task = _loopScheduler.next(now())) >= 0) {
+    if (!loopRun(task)) {
+      return false;
+    }
+    now(true);
+  }
+
+  // nothing is due, sleep until the earliest deadline
+  uint32_t sleep = _loopScheduler.idle(now(), OPTA2IOT_LOOP_SLEEP);
+  if (sleep > 0) {
+    delay(sleep);
+  }
+
+  return running();
+}
+
+void Opta::loopSchedule() {
+  // Registration order gives the priority
+  _loopScheduler.add(LoopTask::LoopIo, OPTA2IOT_IO_POLL, now());
+  _loopScheduler.add(LoopTask::LoopModbus, modbusIsServer() && modbusIsRtu() ? OPTA2IOT_MODBUS_POLL : OPTA2IOT_MODBUS_TCP_POLL, now());
+  if (rs485IsEnabled()) {
+    _loopScheduler.add(LoopTask::LoopRs485, OPTA2IOT_RS485_POLL, now());
+  }
+  _loopScheduler.add(LoopTask::LoopButton, OPTA2IOT_BUTTON_POLL, now());
+  _loopScheduler.add(LoopTask::LoopMqtt, OPTA2IOT_MQTT_POLL, now());
+  _loopScheduler.add(LoopTask::LoopJournal, OPTA2IOT_JOURNAL_POLL, now());
+  _loopScheduler.add(LoopTask::LoopNetwork, OPTA2IOT_LINK_POLL, now());
+  _loopScheduler.add(LoopTask::LoopSerial, OPTA2IOT_SERIAL_POLL, now());
+  _loopScheduler.add(LoopTask::LoopTime, OPTA2IOT_TIME_POLL, now());
+  _loopScheduler.add(LoopTask::LoopWeb, OPTA2IOT_WEB_POLL, now());
+  _loopScheduler.add(LoopTask::LoopLed, OPTA2IOT_LED_POLL, now());
+}
+
+bool Opta::loopRun(byte task) {
+  bool ret = running();
+  uint32_t start = perfCycles();
+
+  switch (task) {
+    case LoopTask::LoopIo:
+      ret = ioLoop();
+      break;
+    case LoopTask::LoopModbus:
+      ret = modbusLoop();
+      break;
+    case LoopTask::LoopRs485:
+      ret = rs485Loop();
+      break;
+    case LoopTask::LoopButton:
+      ret = buttonLoop();
+      break;
+    case LoopTask::LoopMqtt:
+      ret = mqttLoop();
+      break;
+    case LoopTask::LoopJournal:
+      ret = journalLoop();
+      break;
+    case LoopTask::LoopNetwork:
+      ret = networkLoop();
+      break;
+    case LoopTask::LoopSerial:
+      ret = serialLoop();
+      break;
+    case LoopTask::LoopTime:
+      ret = timeLoop();
+      break;
+    case LoopTask::LoopWeb:
+      ret = webLoop();
+      break;
+    case LoopTask::LoopLed:
+      ret = ledLoop();
+      break;
+  }
+
+  if (_perfStarted && task < PerfTasksMax) {
+    // cycles to microseconds
+    _perfTasks[task].add((perfCycles() - start) / (SystemCoreClock / 1000000));
+  }
+
+  return ret;
+}
+
+const char *Opta::loopName(byte task) {
+  switch (task) {
+    case LoopTask::LoopIo:
+      return "io";
+    case LoopTask::LoopModbus:
+      return "modbus";
+    case LoopTask::LoopRs485:
+      return "rs485";
+    case LoopTask::LoopButton:
+      return "button";
+    case LoopTask::LoopMqtt:
+      return "mqtt";
+    case LoopTask::LoopJournal:
+      return "journal";
+    case LoopTask::LoopNetwork:
+      return "network";
+    case LoopTask::LoopSerial:
+      return "serial";
+    case LoopTask::LoopTime:
+      return "time";
+    case LoopTask::LoopWeb:
+      return "web";
+    case LoopTask::LoopLed:
+      return "led";
+  }
+
+  return "unknown";
 }
 
 bool Opta::endSetup() {
@@ -119,6 +232,7 @@ bool Opta::endSetup() {
 bool Opta::startLoop() {
   now(true);
   odd(true);
+  timeBenchmark();
 
   watchdogPing();
 
@@ -166,6 +280,7 @@ void Opta::reset() {
   serialInfo(label_main_reset);
 
   kv_remove("config");
+  kv_remove("configbin");
   delay(10);
   configReadFromDefault();
   delay(10);
@@ -212,6 +327,73 @@ int Opta::getHex(int value) {
   return as_hex;
 }
 
+/*
+ * Profiler
+ */
+
+bool Opta::perfSetup() {
+  serialLine(label_perf_setup);
+
+  // Enable DWT cycle counter, M7 requires to unlock DWT first
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  uint32_t cycles = perfCycles();
+  delayMicroseconds(1);
+  _perfStarted = perfCycles() != cycles;
+  if (!_perfStarted) {
+    serialWarn(label_perf_none);
+  }
+
+  watchdogPing();
+
+  return running();
+}
+
+uint32_t Opta::perfCycles() {
+  return DWT->CYCCNT;
+}
+
+void Opta::perfReset() {
+  serialInfo(label_perf_reset);
+
+  for (byte i = 0; i < PerfTasksMax; i++) {
+    _perfTasks[i].reset();
+  }
+}
+
+void Opta::perfPrint() {
+  serialLine(label_perf_print);
+
+  for (byte i = 0; i < PerfTasksMax; i++) {
+    const Histogram &h = _perfTasks[i];
+    serialInfo(String(loopName(i)) + ": " + String(h.count()) + " / " + String(h.min()) + " / " + String(h.average()) + " / " + String(h.max()) + " / " + String(h.percentile(OPTA2IOT_PERF_PERCENTILE)));
+  }
+}
+
+String Opta::perfToJson() {
+  JsonDocument doc;
+
+  doc["unit"] = "us";
+  doc["percentile"] = OPTA2IOT_PERF_PERCENTILE;
+  for (byte i = 0; i < PerfTasksMax; i++) {
+    const Histogram &h = _perfTasks[i];
+    JsonObject obj = doc["tasks"][loopName(i)].to<JsonObject>();
+    obj["count"] = h.count();
+    obj["min"] = h.min();
+    obj["avg"] = h.average();
+    obj["max"] = h.max();
+    obj["pct"] = h.percentile(OPTA2IOT_PERF_PERCENTILE);
+  }
+
+  String jsonString;
+  serializeJson(doc, jsonString);
+
+  return jsonString;
+}
+
 /*
  * Watchdog
  */
@@ -284,6 +466,12 @@ bool Opta::serialLoop() {
     if (message.equals("loop")) {
       timeLoop(true);
     }
+    if (message.equals("perf")) {
+      perfPrint();
+    }
+    if (message.equals("perf reset")) {
+      perfReset();
+    }
     if (message.equals("ip")) {
       serialLine(label_serial_cmd_ip);
       serialInfo(networkLocalIp().toString());
@@ -540,8 +728,8 @@ bool Opta::flashHasOta() {
 }
 
 bool Opta::flashHasUser() {
-  mbed::MBRBlockDevice user_data(_flashRoot, 2);
-  mbed::FATFileSystem user_data_fs("fs");
+  mbed::MBRBlockDevice user_data(_flashRoot, 4);
+  mbed::FATFileSystem user_data_fs("user");
 
   return user_data_fs.mount(&user_data) == 0;
 }
@@ -764,7 +952,7 @@ bool Opta::ledSetup() {
 }
 
 bool Opta::ledLoop() {
-  if (now() - _ledConnectionStart > 750) {
+  if (now() - _ledConnectionStart >= 750) {
     // connections
     _ledConnectionState = !_ledConnectionState;
     _ledConnectionStart = now();
@@ -976,13 +1164,14 @@ bool Opta::configSetup() {
   return running();
 }
 
-String Opta::configGetDeviceId() const {
+const String &Opta::configGetDeviceId() const {
   return _configDeviceId;
 }
 
 void Opta::configSetDeviceId(const String &id) {
   serialInfo(label_config_set_deviceid + String(id));
   _configDeviceId = id;
+  mqttSetTopics();
 }
 
 String Opta::configGetDeviceUser() const {
@@ -1124,13 +1313,25 @@ void Opta::configSetMqttPassword(const String &password) {
   _configMqttPassword = password;
 }
 
-String Opta::configGetMqttBase() const {
+const String &Opta::configGetMqttBase() const {
   return _configMqttBase;
 }
 
 void Opta::configSetMqttBase(const String &base) {
   serialInfo(label_config_set_mqttbase + String(base));
   _configMqttBase = base;
+  mqttSetTopics();
+}
+
+byte Opta::configGetMqttBatch() const {
+  return _configMqttBatch;
+}
+
+void Opta::configSetMqttBatch(byte batch) {
+  if (batch <= MqttBatch::MqttBatchPack) {
+    serialInfo(label_config_set_mqttbatch + String(batch));
+    _configMqttBatch = batch;
+  }
 }
 
 int Opta::configGetMqttInterval() const {
@@ -1188,6 +1389,65 @@ void Opta::configSetModbusPort(const int port) {
   _configModbusPort = port;
 }
 
+uint32_t Opta::configGetRs485Baudrate() const {
+  return _configRs485Baudrate;
+}
+
+void Opta::configSetRs485Baudrate(uint32_t baudrate) {
+  if (baudrate >= 1200 && baudrate <= 921600) {
+    serialInfo(label_config_set_rs485baudrate + String(baudrate));
+    _configRs485Baudrate = baudrate;
+  }
+}
+
+byte Opta::configGetRs485Parity() const {
+  return _configRs485Parity;
+}
+
+void Opta::configSetRs485Parity(byte parity) {
+  if (parity <= 2) {
+    serialInfo(label_config_set_rs485parity + String(parity));
+    _configRs485Parity = parity;
+  }
+}
+
+bool Opta::configGetRs485Bridge() const {
+  return _configRs485Bridge;
+}
+
+void Opta::configSetRs485Bridge(bool bridge) {
+  serialInfo(label_config_set_rs485bridge + String(bridge));
+  _configRs485Bridge = bridge;
+}
+
+uint16_t Opta::configGetRs485Window() const {
+  return _configRs485Window;
+}
+
+void Opta::configSetRs485Window(uint16_t window) {
+  serialInfo(label_config_set_rs485window + String(window));
+  _configRs485Window = window;
+}
+
+size_t Opta::configGetModbusScansNum() const {
+  return _configModbusScansNum;
+}
+
+bool Opta::configAddModbusScan(uint8_t server, uint8_t function, uint16_t start, uint16_t length, uint32_t period) {
+  if (_configModbusScansNum >= ModbusScansMax || function < 1 || function > 4 || length < 1 || length > (function <= 2 ? 2000 : 125)) {
+    return false;
+  }
+
+  serialInfo(label_config_set_modbusscan + String(server) + "/" + String(function) + "/" + String(start) + "/" + String(length) + "/" + String(period));
+  _configModbusScans[_configModbusScansNum++] = { server, function, start, length, period };
+
+  return true;
+}
+
+void Opta::configClearModbusScans() {
+  _configModbusScansNum = 0;
+}
+
 byte Opta::configGetInputType(size_t index) {
   if (index < boardGetInputsNum()) {
     return _configInputs[index];
@@ -1203,6 +1463,21 @@ bool Opta::configSetInputType(size_t index, byte type) {
   return false;
 }
 
+uint16_t Opta::configGetInputDeadband(size_t index) {
+  if (index < boardGetInputsNum()) {
+    return _configInputsDeadband[index];
+  }
+  return 0;
+}
+
+bool Opta::configSetInputDeadband(size_t index, uint16_t deadband) {
+  if (index < boardGetInputsNum() && deadband <= 10000) {
+    _configInputsDeadband[index] = deadband;
+    return true;
+  }
+  return false;
+}
+
 bool Opta::configReadFromJson(const char *buffer, size_t length) {
   serialInfo(label_config_json_read);
 
@@ -1215,6 +1490,25 @@ bool Opta::configReadFromJson(const char *buffer, size_t length) {
     return false;
   }
 
+  return configFromJson(doc);
+}
+
+bool Opta::configReadFromJson(Stream &input) {
+  serialInfo(label_config_json_read);
+
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, input);
+
+  if (error) {
+    serialWarn(label_config_json_read_error);
+
+    return false;
+  }
+
+  return configFromJson(doc);
+}
+
+bool Opta::configFromJson(JsonDocument &doc) {
   if (doc["deviceId"].isNull()
       || doc["deviceUser"].isNull()
       || doc["devicePassword"].isNull()
@@ -1241,6 +1535,35 @@ bool Opta::configReadFromJson(const char *buffer, size_t length) {
     serialWarn(label_config_json_uncomplete);
   }
 
+  // strings must fit in binary record, else configuration read after reboot would differ from running one
+  const struct {
+    const char *key;
+    size_t size;
+  } strings[] = {
+    { "deviceId", sizeof(ConfigRecord::deviceId) },
+    { "deviceUser", sizeof(ConfigRecord::deviceUser) },
+    { "devicePassword", sizeof(ConfigRecord::devicePassword) },
+    { "netIp", sizeof(ConfigRecord::networkIp) },
+    { "netGateway", sizeof(ConfigRecord::networkGateway) },
+    { "netSubnet", sizeof(ConfigRecord::networkSubnet) },
+    { "netDns", sizeof(ConfigRecord::networkDns) },
+    { "netSsid", sizeof(ConfigRecord::networkSsid) },
+    { "netPassword", sizeof(ConfigRecord::networkPassword) },
+    { "mqttIp", sizeof(ConfigRecord::mqttIp) },
+    { "mqttUser", sizeof(ConfigRecord::mqttUser) },
+    { "mqttPassword", sizeof(ConfigRecord::mqttPassword) },
+    { "mqttBase", sizeof(ConfigRecord::mqttBase) },
+    { "modbusIp", sizeof(ConfigRecord::modbusIp) }
+  };
+  for (const auto &field : strings) {
+    const char *value = doc[field.key];
+    if (value && strlen(value) >= field.size) {
+      serialWarn(label_config_json_too_long + String(field.key));
+
+      return false;
+    }
+  }
+
   if (!doc["deviceId"].isNull()) {
     configSetDeviceId(doc["deviceId"].as<String>());
   }
@@ -1295,6 +1618,9 @@ bool Opta::configReadFromJson(const char *buffer, size_t length) {
   if (!doc["mqttInterval"].isNull()) {
     configSetMqttInterval(doc["mqttInterval"].as<int>());
   }
+  if (!doc["mqttBatch"].isNull()) {
+    configSetMqttBatch(doc["mqttBatch"].as<int>());
+  }
   if (!doc["modbusType"].isNull()) {
       configSetModbusType(doc["modbusType"].as<int>());
   }
@@ -1314,16 +1640,136 @@ bool Opta::configReadFromJson(const char *buffer, size_t length) {
     if (!doc["inputs"].isNull() && !doc["inputs"][pinName].isNull()) {
       configSetInputType(i, doc["inputs"][pinName].as<int>());
     }
+    if (!doc["deadbands"].isNull() && !doc["deadbands"][pinName].isNull()) {
+      configSetInputDeadband(i, doc["deadbands"][pinName].as<int>());
+    }
+  }
+
+  if (!doc["rs485Baudrate"].isNull()) {
+    configSetRs485Baudrate(doc["rs485Baudrate"].as<uint32_t>());
+  }
+  if (!doc["rs485Parity"].isNull()) {
+    configSetRs485Parity(doc["rs485Parity"].as<int>());
+  }
+  if (!doc["rs485Bridge"].isNull()) {
+    configSetRs485Bridge(doc["rs485Bridge"].as<bool>());
+  }
+  if (!doc["rs485Window"].isNull()) {
+    configSetRs485Window(doc["rs485Window"].as<int>());
+  }
+
+  if (!doc["modbusScan"].isNull()) {
+    configClearModbusScans();
+    for (JsonObject scan : doc["modbusScan"].as<JsonArray>()) {
+      configAddModbusScan(scan["server"] | 1, scan["function"] | 3, scan["start"] | 0, scan["length"] | 1, scan["period"] | 1000);
+    }
   }
 
   return true;
 }
 
+byte Opta::configDiff(JsonDocument &previous) {
+  // subsystems to reinitialize for each configuration field
+  static const struct {
+    const char *key;
+    byte scope;
+  } fields[] = {
+    { "deviceId", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "deviceUser", ConfigScopeWeb | ConfigScopeRegisters },
+    { "devicePassword", ConfigScopeWeb | ConfigScopeRegisters },
+    { "timeOffset", ConfigScopeTime | ConfigScopeRegisters },
+    { "netIp", ConfigScopeReboot },
+    { "netGateway", ConfigScopeReboot },
+    { "netSubnet", ConfigScopeReboot },
+    { "netDns", ConfigScopeReboot },
+    { "netDhcp", ConfigScopeReboot },
+    { "netWifi", ConfigScopeReboot },
+    { "netSsid", ConfigScopeReboot },
+    { "netPassword", ConfigScopeReboot },
+    { "mqttIp", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "mqttPort", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "mqttUser", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "mqttPassword", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "mqttBase", ConfigScopeMqtt | ConfigScopeRegisters },
+    { "mqttInterval", ConfigScopeRegisters },
+    { "mqttBatch", ConfigScopeNone },
+    { "modbusType", ConfigScopeReboot },
+    { "modbusId", ConfigScopeModbus | ConfigScopeRegisters },
+    { "modbusIp", ConfigScopeReboot },
+    { "modbusPort", ConfigScopeReboot },
+    { "inputs", ConfigScopeIo | ConfigScopeRegisters },
+    { "deadbands", ConfigScopeNone },
+    { "modbusScan", ConfigScopeModbus },
+    { "rs485Baudrate", ConfigScopeReboot },
+    { "rs485Parity", ConfigScopeReboot },
+    { "rs485Bridge", ConfigScopeMqtt },
+    { "rs485Window", ConfigScopeNone },
+  };
+
+  JsonDocument current;
+  configToJson(current, false);
+
+  byte scope = ConfigScopeNone;
+  for (const auto &field : fields) {
+    if (previous[field.key] != current[field.key]) {
+      scope |= field.scope;
+    }
+  }
+
+  // MQTT client is only created on setup
+  if (previous["mqttIp"].as<String>().equals("0.0.0.0") == mqttIsEnabled()) {
+    scope |= ConfigScopeReboot;
+  }
+
+  return scope;
+}
+
+void Opta::configApply(byte scope, JsonDocument &previous) {
+  if (scope & ConfigScopeWeb) {
+    webSetAuth();
+  }
+  if (scope & ConfigScopeTime) {
+    // clock holds local time
+    set_time(time(nullptr) + (configGetTimeOffset() - previous["timeOffset"].as<int>()) * 3600);
+  }
+  if (scope & ConfigScopeIo) {
+    for (size_t i = 0; i < boardGetInputsNum(); i++) {
+      if (previous["inputs"]["I" + String(i + 1)].as<int>() != configGetInputType(i)) {
+        ioSetupInput(i);
+      }
+    }
+  }
+  if ((scope & ConfigScopeMqtt) && mqttIsEnabled()) {
+    mqttRestart();
+  }
+  if (scope & ConfigScopeModbus) {
+    modbusRestart();
+  }
+  if ((scope & ConfigScopeRegisters) && modbusIsEnabled() && modbusIsServer()) {
+    modbusSetRegisters();
+  }
+}
+
 String Opta::configWriteToJson(const bool nopass) {
   //serialInfo("Writing configuration to JSON");
 
   JsonDocument doc;
+  configToJson(doc, nopass);
+
+  String jsonString;
+  serializeJson(doc, jsonString);
+
+  return jsonString;
+}
+
+size_t Opta::configWriteToJson(Print &output, const bool nopass) {
+  JsonDocument doc;
+  configToJson(doc, nopass);
+
+  return serializeJson(doc, output);
+}
 
+void Opta::configToJson(JsonDocument &doc, const bool nopass) {
   doc["version"] = version();
   doc["deviceId"] = configGetDeviceId();
   doc["deviceUser"] = configGetDeviceUser();
@@ -1343,20 +1789,31 @@ String Opta::configWriteToJson(const bool nopass) {
   doc["mqttPassword"] = nopass ? "" : configGetMqttPassword();
   doc["mqttBase"] = configGetMqttBase();
   doc["mqttInterval"] = configGetMqttInterval();
+  doc["mqttBatch"] = configGetMqttBatch();
   doc["modbusType"] = configGetModbusType();
   doc["modbusId"] = configGetModbusId();
   doc["modbusIp"] = configGetModbusIp();
   doc["modbusPort"] = configGetModbusPort();
+  doc["rs485Baudrate"] = configGetRs485Baudrate();
+  doc["rs485Parity"] = configGetRs485Parity();
+  doc["rs485Bridge"] = configGetRs485Bridge();
+  doc["rs485Window"] = configGetRs485Window();
 
   for (size_t i = 0; i < boardGetInputsNum(); ++i) {
     String pinName = "I" + String(i + 1);
     doc["inputs"][pinName] = configGetInputType(i);
+    doc["deadbands"][pinName] = configGetInputDeadband(i);
   }
 
-  String jsonString;
-  serializeJson(doc, jsonString);
-
-  return jsonString;
+  JsonArray scans = doc["modbusScan"].to<JsonArray>();
+  for (size_t i = 0; i < _configModbusScansNum; i++) {
+    JsonObject scan = scans.add<JsonObject>();
+    scan["server"] = _configModbusScans[i].server;
+    scan["function"] = _configModbusScans[i].function;
+    scan["start"] = _configModbusScans[i].start;
+    scan["length"] = _configModbusScans[i].length;
+    scan["period"] = _configModbusScans[i].period;
+  }
 }
 
 void Opta::configReadFromDefault() {
@@ -1382,136 +1839,713 @@ void Opta::configReadFromDefault() {
   configSetMqttPassword(OPTA2IOT_MQTT_PASSWORD);
   configSetMqttBase(OPTA2IOT_MQTT_BASE);
   configSetMqttInterval(OPTA2IOT_MQTT_INTERVAL);
+  configSetMqttBatch(OPTA2IOT_MQTT_BATCH);
 
   configSetModbusType(OPTA2IOT_MODBUS_TYPE);
   configSetModbusId(OPTA2IOT_MODBUS_ID);
   configSetModbusIp(OPTA2IOT_MODBUS_IP);
   configSetModbusPort(OPTA2IOT_MODBUS_PORT);
+  configClearModbusScans();
+
+  configSetRs485Baudrate(OPTA2IOT_RS485_BAUDRATE);
+  configSetRs485Parity(OPTA2IOT_RS485_PARITY);
+  configSetRs485Bridge(OPTA2IOT_RS485_BRIDGE);
+  configSetRs485Window(OPTA2IOT_RS485_WINDOW);
 
   for (size_t i = 0; i < boardGetInputsNum(); i++) {
     configSetInputType(i, IoType::IoDigital);
+    configSetInputDeadband(i, OPTA2IOT_IO_DEADBAND);
   }
 }
 
 bool Opta::configWriteToFile() {
-  String str = configWriteToJson(false);
+  struct {
+    ConfigHeader header;
+    ConfigRecord record;
+  } file;
+  memset(&file, 0, sizeof(file));  // no random padding bytes in CRC
+
+  configToRecord(file.record);
+  file.header.magic = ConfigRecordMagic;
+  file.header.version = ConfigRecordVersion;
+  file.header.size = configRecordEnd(ConfigRecordVersion);
+  file.header.crc = configCrc(&file.record, file.header.size);
 
   serialInfo(label_config_file_write);
-  kv_set("config", str.c_str(), str.length(), 0);
 
-  return true;
+  return kv_set("configbin", &file, sizeof(file.header) + file.header.size, 0) == MBED_SUCCESS;
 }
 
 bool Opta::configReadFromFile() {
   serialInfo(label_config_file_read);
 
-  bool ret = true;
-  char readBuffer[1024];
-  kv_get("config", readBuffer, 1024, 0);
-  if (configReadFromJson(readBuffer, 1024) < 1) {
-    serialWarn(label_config_file_error);
-    reset();
-    ret = false;
+  if (configReadFromRecord() || configReadFromLegacy()) {
+    return true;
   }
 
-  return ret;
-}
-
-/*
- * IO
- */
-
-bool Opta::ioSetup() {
-  serialLine(label_io_setup);
+  serialWarn(label_config_file_error);
+  reset();
 
-  serialInfo(label_io_resolution + String(ioResolution()));
-  analogReadResolution(ioResolution());
+  return false;
+}
 
-  for (size_t i = 0; i < boardGetInputsNum(); ++i) {
-    serialInfo("Set input " + String(i + 1) + " of type " + String(configGetInputType(i)) + " on pin " + String(BoardInputs[i]));
-    if (configGetInputType(i) == IoType::IoDigital || configGetInputType(i) == IoType::IoPulse) {
-      pinMode(BoardInputs[i], INPUT);
-      _ioPreviousState[i] = String(ioGetDigitalInput(i)).c_str();
-    } else {
-      _ioPreviousState[i] = String(ioGetAnalogInputString(i)).c_str();
-    }
+bool Opta::configReadFromRecord() {
+  struct {
+    ConfigHeader header;
+    ConfigRecord record;
+  } file;
+  size_t actual = 0;
+  if (kv_get("configbin", &file, sizeof(file), &actual) != MBED_SUCCESS
+      || actual < sizeof(file.header)
+      || file.header.magic != ConfigRecordMagic
+      || file.header.size > sizeof(file.record)
+      || actual != sizeof(file.header) + file.header.size
+      || file.header.crc != configCrc(&file.record, file.header.size)) {
+    return false;
   }
 
-  for (size_t i = 0; i < boardGetOutputsNum(); ++i) {
-    serialInfo("Set output " + String(i + 1) + " on pin " + String(BoardInputs[i]) + " with LED on pin " + BoardOutputsLeds[i]);
-    pinMode(BoardOutputs[i], OUTPUT);
-    pinMode(BoardOutputsLeds[i], OUTPUT);
-
-    ioSetDigitalOuput(i, false);
+  // fields missing from an older record keep current (default) values,
+  // records written with their trailing padding must not overwrite them
+  size_t size = file.header.size;
+  if (size > configRecordEnd(file.header.version)) {
+    size = configRecordEnd(file.header.version);
   }
+  ConfigRecord record;
+  configToRecord(record);
+  memcpy(&record, &file.record, size);
+  configFromRecord(record);
 
-  watchdogPing();
+  if (file.header.version != ConfigRecordVersion || file.header.size != configRecordEnd(ConfigRecordVersion)) {
+    serialInfo(label_config_file_migrate + String(file.header.version));
+    configWriteToFile();
+  }
 
-  return running();
+  return true;
 }
 
-bool Opta::ioLoop() {
-  if (ioPoll()) {
-
-    // Update mqtt values
-    if (mqttIsConnected()) {
-      String inputsCurrent[BoardInputsMax];
-      for (size_t i = 0; i < boardGetInputsNum(); i++) {
-        if (configGetInputType(i) == IoType::IoAnalog) {
-          inputsCurrent[i] = String(ioGetAnalogInputString(i)).c_str();
-        } else {
-          inputsCurrent[i] = String(ioGetDigitalInput(i)).c_str();
-        }
+size_t Opta::configRecordEnd(uint16_t version) {
+  // end of last field of each record version
+  switch (version) {
+    case 1:
+      return offsetof(ConfigRecord, inputsDeadband) + sizeof(ConfigRecord::inputsDeadband);
+    case 2:
+      return offsetof(ConfigRecord, modbusScans) + sizeof(ConfigRecord::modbusScans);
+    case 3:
+      return offsetof(ConfigRecord, rs485Parity) + sizeof(ConfigRecord::rs485Parity);
+    default:
+      return offsetof(ConfigRecord, rs485Window) + sizeof(ConfigRecord::rs485Window);
+  }
+}
 
-        if (!inputsCurrent[i].equals(_ioPreviousState[i])) {
-          //ts ... && only 1 for pulse
-          if ((configGetInputType(i) != IoType::IoPulse) || inputsCurrent[i].equals(String('1'))) {
-            String inTopic = "I" + String(i + 1);
-            String rootTopic = configGetMqttBase() + configGetDeviceId() + "/";
+bool Opta::configReadFromLegacy() {
+  // JSON configuration from previous versions, imported once
+  kv_info_t info;
+  if (kv_get_info("config", &info) != MBED_SUCCESS || info.size == 0) {
+    return false;
+  }
 
-            mqttPublish(String(rootTopic + inTopic + "/val").c_str(), String(inputsCurrent[i]).c_str());
-            mqttPublish(String(rootTopic + inTopic + "/type").c_str(), String(configGetInputType(i)).c_str());
+  char *buffer = new char[info.size];
+  size_t actual = 0;
+  bool ret = kv_get("config", buffer, info.size, &actual) == MBED_SUCCESS && configReadFromJson(buffer, actual);
+  delete[] buffer;
 
-            serialInfo(String("[" + inTopic + "] " + _ioPreviousState[i] + " => " + inputsCurrent[i]).c_str());
-          }
-          _ioPreviousState[i] = inputsCurrent[i];
-        }
-      }
+  if (ret) {
+    serialInfo(label_config_file_legacy);
+    if (configWriteToFile()) {
+      kv_remove("config");
     }
+  }
 
-    // Update modbus values
-    if (modbusIsEnabled() && modbusIsServer()) {
-      size_t reg = 30; // Modbus Holding Registers Inputs part always starts at offset 30
-
-      reg++; // Skip fisrt offset
-      reg++; // Skip number of inputs
-      for (size_t i = 0; i < boardGetInputsNum(); i++) {
-        reg++; // Skip type of input
-        if (configGetInputType(i) == IoType::IoAnalog) {
-          modbusSetInputRegister(reg++, ioGetAnalogInput(i) * 1000); // in mV
-        } else {
-          modbusSetInputRegister(reg++, ioGetDigitalInput(i));
-        }
-      }
+  return ret;
+}
 
-      for (size_t i = 0; i < boardGetOutputsNum(); i++) {
-        modbusSetCoil(i, ioGetDigitalOutput(i));
-      }
+void Opta::configToRecord(ConfigRecord &record) {
+  auto copy = [](char *target, size_t size, const String &source) {
+    strncpy(target, source.c_str(), size - 1);
+    target[size - 1] = '\0';
+  };
+
+  copy(record.deviceId, sizeof(record.deviceId), configGetDeviceId());
+  copy(record.deviceUser, sizeof(record.deviceUser), configGetDeviceUser());
+  copy(record.devicePassword, sizeof(record.devicePassword), configGetDevicePassword());
+  record.timeOffset = configGetTimeOffset();
+  record.networkDhcp = configGetNetworkDhcp();
+  record.networkWifi = configGetNetworkWifi();
+  copy(record.networkIp, sizeof(record.networkIp), configGetNetworkIp());
+  copy(record.networkGateway, sizeof(record.networkGateway), configGetNetworkGateway());
+  copy(record.networkSubnet, sizeof(record.networkSubnet), configGetNetworkSubnet());
+  copy(record.networkDns, sizeof(record.networkDns), configGetNetworkDns());
+  copy(record.networkSsid, sizeof(record.networkSsid), configGetNetworkSsid());
+  copy(record.networkPassword, sizeof(record.networkPassword), configGetNetworkPassword());
+  copy(record.mqttIp, sizeof(record.mqttIp), configGetMqttIp());
+  record.mqttPort = configGetMqttPort();
+  copy(record.mqttUser, sizeof(record.mqttUser), configGetMqttUser());
+  copy(record.mqttPassword, sizeof(record.mqttPassword), configGetMqttPassword());
+  copy(record.mqttBase, sizeof(record.mqttBase), configGetMqttBase());
+  record.mqttInterval = configGetMqttInterval();
+  record.mqttBatch = configGetMqttBatch();
+  record.modbusType = configGetModbusType();
+  record.modbusId = configGetModbusId();
+  copy(record.modbusIp, sizeof(record.modbusIp), configGetModbusIp());
+  record.modbusPort = configGetModbusPort();
+  for (size_t i = 0; i < BoardInputsMax; i++) {
+    record.inputs[i] = _configInputs[i];
+    record.inputsDeadband[i] = _configInputsDeadband[i];
+  }
+  record.modbusScansNum = _configModbusScansNum;
+  memcpy(record.modbusScans, _configModbusScans, sizeof(record.modbusScans));
+  record.rs485Baudrate = configGetRs485Baudrate();
+  record.rs485Parity = configGetRs485Parity();
+  record.rs485Bridge = configGetRs485Bridge();
+  record.rs485Window = configGetRs485Window();
+}
+
+void Opta::configFromRecord(const ConfigRecord &record) {
+  configSetDeviceId(record.deviceId);
+  configSetDeviceUser(record.deviceUser);
+  configSetDevicePassword(record.devicePassword);
+  configSetTimeOffset(record.timeOffset);
+  configSetNetworkDhcp(record.networkDhcp);
+  configSetNetworkWifi(record.networkWifi);
+  configSetNetworkIp(record.networkIp);
+  configSetNetworkGateway(record.networkGateway);
+  configSetNetworkSubnet(record.networkSubnet);
+  configSetNetworkDns(record.networkDns);
+  configSetNetworkSsid(record.networkSsid);
+  configSetNetworkPassword(record.networkPassword);
+  configSetMqttIp(record.mqttIp);
+  configSetMqttPort(record.mqttPort);
+  configSetMqttUser(record.mqttUser);
+  configSetMqttPassword(record.mqttPassword);
+  configSetMqttBase(record.mqttBase);
+  configSetMqttInterval(record.mqttInterval);
+  configSetMqttBatch(record.mqttBatch);
+  configSetModbusType(record.modbusType);
+  configSetModbusId(record.modbusId);
+  configSetModbusIp(record.modbusIp);
+  configSetModbusPort(record.modbusPort);
+  for (size_t i = 0; i < boardGetInputsNum(); i++) {
+    configSetInputType(i, record.inputs[i]);
+    configSetInputDeadband(i, record.inputsDeadband[i]);
+  }
+  configClearModbusScans();
+  for (size_t i = 0; i < record.modbusScansNum && i < ModbusScansMax; i++) {
+    const ModbusScan &scan = record.modbusScans[i];
+    configAddModbusScan(scan.server, scan.function, scan.start, scan.length, scan.period);
+  }
+  configSetRs485Baudrate(record.rs485Baudrate);
+  configSetRs485Parity(record.rs485Parity);
+  configSetRs485Bridge(record.rs485Bridge);
+  configSetRs485Window(record.rs485Window);
+}
+
+uint32_t Opta::configCrc(const void *data, size_t length) {
+  // CRC32 (IEEE), bitwise, only used on config load and save
+  const uint8_t *bytes = (const uint8_t *)data;
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    for (byte j = 0; j < 8; j++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
     }
   }
 
-  return running();
+  return ~crc;
 }
 
-bool Opta::ioPoll() {
-  if ((OPTA2IOT_IO_POLL > 0) && ((_ioLastPoll == 0) || ((now() - _ioLastPoll) > OPTA2IOT_IO_POLL))) {
-    _ioLastPoll = now();
+/*
+ * Journal
+ */
 
-    return true;
+bool Opta::journalSetup() {
+  serialLine(label_journal_setup);
+
+  if (!OPTA2IOT_JOURNAL_SIZE || !mqttIsEnabled()) {
+    serialWarn(label_journal_none);
+
+    return running();
   }
 
-  return false;
-}
+  // raw region outside of partitions, written without filesystem so no sector is rewritten on each batch
+  _journalDevice = new mbed::SlicingBlockDevice(_flashRoot, OPTA2IOT_JOURNAL_ADDRESS, OPTA2IOT_JOURNAL_ADDRESS + OPTA2IOT_JOURNAL_SIZE * sizeof(JournalRecord));
+  bool ready = _journalDevice->init() == 0;
+  size_t erase = ready ? _journalDevice->get_erase_size() : 0;
+  if (!ready
+      || erase % sizeof(JournalRecord) != 0
+      || sizeof(JournalRecord) % _journalDevice->get_program_size() != 0
+      || (OPTA2IOT_JOURNAL_SIZE * sizeof(JournalRecord)) % erase != 0) {
+    serialWarn(label_journal_device_error);
+    delete _journalDevice;
+    _journalDevice = nullptr;
+
+    return running();
+  }
+  _journalSector = erase / sizeof(JournalRecord);
+
+  // find last written record, erased flash is never a valid record
+  JournalRecord records[16];
+  for (size_t i = 0; i < OPTA2IOT_JOURNAL_SIZE; i += 16) {
+    _journalDevice->read(records, i * sizeof(JournalRecord), sizeof(records));
+    for (size_t j = 0; j < 16; j++) {
+      if (records[j].seq && records[j].check == journalCheck(records[j]) && records[j].seq > _journalHead) {
+        _journalHead = records[j].seq;
+      }
+    }
+    watchdogPing();
+  }
+
+  // get last replayed record
+  size_t actual = 0;
+  if (kv_get("journal", &_journalAck, sizeof(_journalAck), &actual) != MBED_SUCCESS || actual != sizeof(_journalAck) || _journalAck > _journalHead) {
+    _journalAck = _journalHead;
+  }
+
+  // a sector is erased when its first slot is written, next slots of current sector must still be erased
+  size_t slot = (_journalHead + 1) % OPTA2IOT_JOURNAL_SIZE;
+  bool erased = true;
+  for (size_t i = slot; erased && i % _journalSector != 0; i++) {
+    JournalRecord record;
+    _journalDevice->read(&record, i * sizeof(JournalRecord), sizeof(record));
+    const uint8_t *bytes = (const uint8_t *)&record;
+    for (size_t j = 0; j < sizeof(record); j++) {
+      erased &= bytes[j] == 0xFF;
+    }
+  }
+  if (!erased) {
+    serialWarn(label_journal_skip);
+    bool replayed = _journalAck == _journalHead;
+    _journalHead += _journalSector - slot % _journalSector;
+    if (replayed) {
+      _journalAck = _journalHead;
+    }
+  }
+
+  serialInfo(label_journal_pending + String(journalPending()));
+
+  watchdogPing();
+
+  return running();
+}
+
+bool Opta::journalLoop() {
+  if (journalIsEnabled()) {
+    // write to flash by batch, or at once before replay
+    if (_journalBuffered && (mqttIsConnected() || _journalBuffered >= OPTA2IOT_JOURNAL_BUFFER || now() - _journalBufferStart >= OPTA2IOT_JOURNAL_FLUSH)) {
+      journalFlush();
+    }
+
+    if (mqttIsConnected() && !_journalBuffered && journalPending()) {
+      journalReplay();
+    }
+  }
+
+  return running();
+}
+
+bool Opta::journalIsEnabled() {
+  return _journalDevice != nullptr;
+}
+
+size_t Opta::journalPending() {
+  size_t pending = _journalHead - _journalAck;
+
+  return pending < OPTA2IOT_JOURNAL_SIZE ? pending : OPTA2IOT_JOURNAL_SIZE;
+}
+
+void Opta::journalWrite(size_t index, uint32_t value) {
+  _journalOffline = true;
+
+  if (!journalIsEnabled()) {
+    return;
+  }
+  if (_journalBuffered >= OPTA2IOT_JOURNAL_BUFFER) {
+    journalFlush();
+  }
+  if (!_journalBuffered) {
+    _journalBufferStart = now();
+  }
+
+  JournalRecord &record = _journalBuffer[_journalBuffered++];
+  record.seq = ++_journalHead;
+  record.time = time(NULL);
+  record.value = value;
+  record.index = index;
+  record.type = configGetInputType(index);
+  record.check = journalCheck(record);
+}
+
+bool Opta::journalFlush() {
+  if (!_journalBuffered) {
+    return true;
+  }
+
+  // record position only depends on its sequence, a sector is erased once per wrap when its first slot is written,
+  // records are programmed by runs that never cross a sector end
+  bool ret = true;
+  for (size_t i = 0; ret && i < _journalBuffered;) {
+    size_t slot = _journalBuffer[i].seq % OPTA2IOT_JOURNAL_SIZE;
+    if (slot % _journalSector == 0) {
+      ret = _journalDevice->erase(slot * sizeof(JournalRecord), _journalSector * sizeof(JournalRecord)) == 0;
+    }
+    size_t count = _journalSector - slot % _journalSector;
+    if (count > _journalBuffered - i) {
+      count = _journalBuffered - i;
+    }
+    ret = ret && _journalDevice->program(_journalBuffer + i, slot * sizeof(JournalRecord), count * sizeof(JournalRecord)) == 0;
+    i += count;
+  }
+
+  if (!ret) {
+    serialWarn(label_journal_write_error);
+  }
+  _journalBuffered = 0;
+
+  return ret;
+}
+
+bool Opta::journalRead(uint32_t seq, JournalRecord &record) {
+  size_t slot = seq % OPTA2IOT_JOURNAL_SIZE;
+
+  return _journalDevice->read(&record, slot * sizeof(JournalRecord), sizeof(JournalRecord)) == 0
+         && record.seq == seq
+         && record.check == journalCheck(record);
+}
+
+void Opta::journalReplay() {
+  // oldest records were overwritten
+  if (_journalHead - _journalAck > OPTA2IOT_JOURNAL_SIZE) {
+    _journalLost += _journalHead - _journalAck - OPTA2IOT_JOURNAL_SIZE;
+    _journalAck = _journalHead - OPTA2IOT_JOURNAL_SIZE;
+  }
+
+  const char *topic = mqttTopic(MqttTopicJournal);
+  for (size_t i = 0; i < OPTA2IOT_JOURNAL_BURST && _journalAck != _journalHead; i++) {
+    uint32_t seq = _journalAck + 1;
+    JournalRecord record;
+    if (journalRead(seq, record)) {
+      JsonDocument doc;
+      String inTopic = "I" + String(record.index + 1);
+      doc["time"] = record.time;
+      if (record.type == IoType::IoAnalog) {
+        doc[inTopic] = record.value / 100 / 10.0;  // in volts, one decimal
+      } else if (record.type == IoType::IoPulse) {
+        doc[inTopic] = 1;
+        doc["count"][inTopic] = record.value;
+      } else {
+        doc[inTopic] = record.value;
+      }
+
+      mqttClient.beginMessage(topic, measureJson(doc));
+      serializeJson(doc, mqttClient);
+      mqttClient.endMessage();
+    } else {
+      _journalLost++;  // erased with its sector or corrupted
+    }
+    _journalAck = seq;
+  }
+
+  // do not wear KV store on each burst
+  if (_journalAck == _journalHead || _journalAck % 256 == 0) {
+    kv_set("journal", &_journalAck, sizeof(_journalAck), 0);
+    if (_journalAck == _journalHead) {
+      serialInfo(label_journal_replayed);
+      if (_journalLost) {
+        serialWarn(label_journal_lost + String(_journalLost));
+        mqttPublish(topic, "{\"lost\":" + String(_journalLost) + "}");
+        _journalLost = 0;
+      }
+    }
+  }
+}
+
+uint16_t Opta::journalCheck(const JournalRecord &record) {
+  uint32_t sum = record.seq ^ record.time ^ record.value ^ ((uint32_t)record.index << 8) ^ record.type;
+
+  return (uint16_t)(sum ^ (sum >> 16) ^ 0xA5A5);
+}
+
+/*
+ * IO
+ */
+
+bool Opta::ioSetup() {
+  serialLine(label_io_setup);
+
+  serialInfo(label_io_resolution + String(ioResolution()));
+  analogReadResolution(ioResolution());
+
+  for (size_t i = 0; i < boardGetInputsNum(); ++i) {
+    ioSetupInput(i);
+  }
+
+  for (size_t i = 0; i < boardGetOutputsNum(); ++i) {
+    serialInfo("Set output " + String(i + 1) + " on pin " + String(BoardInputs[i]) + " with LED on pin " + BoardOutputsLeds[i]);
+    pinMode(BoardOutputs[i], OUTPUT);
+    pinMode(BoardOutputsLeds[i], OUTPUT);
+
+    ioSetDigitalOuput(i, false);
+  }
+
+  watchdogPing();
+
+  return running();
+}
+
+bool Opta::ioLoop() {
+  if (ioPoll()) {
+
+    // Changed inputs of this poll when MQTT batch mode is enabled, empty document does not allocate
+    JsonDocument batch;
+
+    // Publish edges captured since last poll
+    ioCaptureDrain(batch);
+
+    // Read raw samples once, nothing is allocated until something has to be published
+    uint16_t samples[BoardInputsMax];
+    for (size_t i = 0; i < boardGetInputsNum(); i++) {
+      samples[i] = ioSample(i);
+    }
+
+    // Update mqtt values, or journal them while broker is not reachable, and mark them for web live data
+    for (size_t i = 0; i < boardGetInputsNum(); i++) {
+      if (ioIsCaptured(i) || !ioSampleChanged(i, samples[i])) {
+        continue;
+      }
+
+      // only 1 for pulse
+      if (mqttIsEnabled() && ((configGetInputType(i) != IoType::IoPulse) || samples[i])) {
+        char previous[10];
+        char current[10];
+        ioSampleToString(i, _ioPreviousSample[i], previous, sizeof(previous));
+        ioSampleToString(i, samples[i], current, sizeof(current));
+
+        ioPublishInput(i, samples[i], batch);
+
+        serialInfo("[I" + String(i + 1) + "] " + previous + " => " + current);
+      }
+      _ioPreviousSample[i] = samples[i];
+      _ioChangedInputs |= 1ULL << i;
+    }
+
+    mqttPublishBatch(batch);
+
+    // Update modbus values
+    if (modbusIsEnabled() && modbusIsServer()) {
+      // single store of changed values into registers image
+      for (size_t i = 0; i < boardGetInputsNum(); i++) {
+        if (configGetInputType(i) == IoType::IoAnalog) {
+          modbusSetRegister(modbusInputValue(i), ioSampleToMillivolts(samples[i])); // in mV
+        } else {
+          modbusSetRegister(modbusInputValue(i), samples[i]);
+          modbusSetDiscreteInput(i, samples[i]);
+        }
+      }
+
+      for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+        modbusSetCoil(i, ioGetDigitalOutput(i));
+      }
+    }
+  }
+
+  return running();
+}
+
+bool Opta::ioPoll() {
+  if ((OPTA2IOT_IO_POLL > 0) && ((_ioLastPoll == 0) || ((now() - _ioLastPoll) >= OPTA2IOT_IO_POLL))) {
+    _ioLastPoll = now();
+
+    return true;
+  }
+
+  return false;
+}
+
+void Opta::ioSetupInput(size_t index) {
+  static void (*const interrupts[8])() = {
+    ioInterrupt<0>, ioInterrupt<1>, ioInterrupt<2>, ioInterrupt<3>,
+    ioInterrupt<4>, ioInterrupt<5>, ioInterrupt<6>, ioInterrupt<7>
+  };
+
+  serialInfo("Set input " + String(index + 1) + " of type " + String(configGetInputType(index)) + " on pin " + String(BoardInputs[index]));
+
+  // input type can change without reboot
+  if (_ioCaptured[index]) {
+    detachInterrupt(digitalPinToInterrupt(BoardInputs[index]));
+  }
+  _ioCaptured[index] = false;
+  _ioPulseCount[index] = _ioPulsePublished[index] = 0;
+  _ioPublishedType[index] = 0xFF;
+  if (configGetInputType(index) == IoType::IoDigital || configGetInputType(index) == IoType::IoPulse) {
+    pinMode(BoardInputs[index], INPUT);
+    _ioCaptureState[index] = ioGetDigitalInput(index);
+
+    if (OPTA2IOT_IO_CAPTURE && index < sizeof(interrupts) / sizeof(interrupts[0])) {
+      serialInfo(label_io_capture + String(index + 1));
+      _ioCaptured[index] = true;
+      // pulse inputs only count rising edges, they never use the edges ring
+      attachInterrupt(digitalPinToInterrupt(BoardInputs[index]), interrupts[index], configGetInputType(index) == IoType::IoPulse ? RISING : CHANGE);
+    }
+  }
+  _ioPreviousSample[index] = ioSample(index);
+  _ioChangedInputs |= 1ULL << index;
+}
+
+void Opta::ioCapture(byte index) {
+  // Called from interrupt: no serial, no allocation
+  if (configGetInputType(index) == IoType::IoPulse) {
+    // attached on RISING, level may already be low again for short pulses
+    _ioPulseCount[index] = _ioPulseCount[index] + 1;
+    return;
+  }
+
+  IoEdge edge;
+  edge.time = micros();
+  edge.index = index;
+  edge.level = digitalRead(BoardInputs[index]) == 1;
+  if (!_ioEdges.push(edge)) {
+    _ioCaptureLost = _ioCaptureLost + 1;
+  }
+}
+
+void Opta::ioCaptureDrain(JsonDocument &batch) {
+  // Digital inputs: publish every level change, even shorter than poll delay
+  IoEdge edge;
+  while (_ioEdges.pop(edge)) {
+    // input type may have changed since the edge was captured
+    if (configGetInputType(edge.index) != IoType::IoDigital || edge.level == _ioCaptureState[edge.index]) {
+      continue;
+    }
+    _ioCaptureState[edge.index] = edge.level;
+    _ioPreviousSample[edge.index] = edge.level;
+    _ioChangedInputs |= 1ULL << edge.index;
+
+    if (mqttIsEnabled()) {
+      ioPublishInput(edge.index, edge.level, batch);
+
+      serialInfo("[I" + String(edge.index + 1) + "] " + String(!edge.level) + " => " + String(edge.level) + " at " + String(edge.time) + "us");
+    }
+  }
+
+  // Pulse inputs: counted in interrupt outside of the ring, publish once per poll
+  for (size_t i = 0; i < boardGetInputsNum(); i++) {
+    if (!ioIsCaptured(i) || configGetInputType(i) != IoType::IoPulse) {
+      continue;
+    }
+    uint32_t count = ioGetPulseCount(i);
+    if (count != _ioPulsePublished[i]) {
+      if (mqttIsEnabled()) {
+        ioPublishInput(i, 1, batch);
+
+        serialInfo("[I" + String(i + 1) + "] " + String(count - _ioPulsePublished[i]) + " pulses, total " + String(count));
+      }
+      _ioPulsePublished[i] = count;
+      _ioChangedInputs |= 1ULL << i;
+    }
+  }
+}
+
+void Opta::ioPublishInput(size_t index, uint16_t sample, JsonDocument &batch) {
+  if (!mqttIsConnected()) {
+    if (configGetInputType(index) == IoType::IoAnalog) {
+      journalWrite(index, ioSampleToMillivolts(sample));
+    } else if (configGetInputType(index) == IoType::IoPulse) {
+      journalWrite(index, ioGetPulseCount(index));
+    } else {
+      journalWrite(index, sample);
+    }
+
+    return;
+  }
+
+  if (mqttIsBatch()) {
+    char inTopic[4];
+    snprintf(inTopic, sizeof(inTopic), "I%u", (unsigned int)(index + 1));
+
+    // same input changed twice in a poll, send previous values first to keep every edge
+    if (!batch[inTopic].isNull()) {
+      mqttPublishBatch(batch);
+    }
+    if (configGetInputType(index) == IoType::IoAnalog) {
+      batch[inTopic] = ioSampleToMillivolts(sample) / 100 / 10.0;  // in volts, one decimal
+    } else {
+      batch[inTopic] = sample ? 1 : 0;
+    }
+    if (ioIsCaptured(index) && configGetInputType(index) == IoType::IoPulse) {
+      batch["count"][inTopic] = ioGetPulseCount(index);
+    }
+  } else {
+    char value[10];
+    ioSampleToString(index, sample, value, sizeof(value));
+
+    mqttPublish(mqttInputTopic(index, MqttInputVal), value);
+    if (ioIsCaptured(index) && configGetInputType(index) == IoType::IoPulse) {
+      mqttPublish(mqttInputTopic(index, MqttInputCount), String(ioGetPulseCount(index)));
+    }
+  }
+
+  // type is only published when it changes
+  if (_ioPublishedType[index] != configGetInputType(index)) {
+    if (mqttPublish(mqttInputTopic(index, MqttInputType), String(configGetInputType(index)))) {
+      _ioPublishedType[index] = configGetInputType(index);
+    }
+  }
+}
+
+uint16_t Opta::ioSample(size_t index) {
+  if (index >= boardGetInputsNum()) {
+    return 0;
+  }
+  if (configGetInputType(index) == IoType::IoAnalog) {
+    return analogRead(BoardInputs[index]);
+  }
+
+  return digitalRead(BoardInputs[index]) == 1 ? 1 : 0;
+}
+
+bool Opta::ioSampleChanged(size_t index, uint16_t sample) {
+  uint16_t previous = _ioPreviousSample[index];
+  if (configGetInputType(index) != IoType::IoAnalog) {
+    return sample != previous;
+  }
+
+  // deadband is configured in mV, compare in raw unit
+  uint32_t deadband = (uint32_t)configGetInputDeadband(index) * ioSampleMax() / 10000;
+  uint32_t delta = sample > previous ? sample - previous : previous - sample;
+
+  return delta > 0 && delta >= deadband;
+}
+
+uint32_t Opta::ioSampleMax() {
+  return (1UL << ioResolution()) - 1;
+}
+
+uint16_t Opta::ioSampleToMillivolts(uint16_t sample) {
+  return (uint32_t)sample * 10000 / ioSampleMax(); // 0 - 10v
+}
+
+void Opta::ioSampleToString(size_t index, uint16_t sample, char *buffer, size_t length) {
+  if (configGetInputType(index) == IoType::IoAnalog) {
+    snprintf(buffer, length, "%0.1f", ioSampleToMillivolts(sample) / 1000.0);
+  } else {
+    snprintf(buffer, length, "%d", sample ? 1 : 0);
+  }
+}
+
+bool Opta::ioIsCaptured(size_t index) {
+  return index < boardGetInputsNum() && _ioCaptured[index];
+}
+
+uint32_t Opta::ioGetPulseCount(size_t index) {
+  if (ioIsCaptured(index)) {
+    return _ioPulseCount[index];
+  }
+
+  return 0;
+}
+
+uint32_t Opta::ioGetCaptureLost() {
+  return _ioCaptureLost;
+}
 
 byte Opta::ioResolution() {
   return OPTA2IOT_IO_RESOLUTION > 0 && OPTA2IOT_IO_RESOLUTION < 17 ? OPTA2IOT_IO_RESOLUTION : 16;
@@ -1527,7 +2561,7 @@ bool Opta::ioGetDigitalInput(size_t index) {
 
 float Opta::ioGetAnalogInput(size_t index) {
   if (index < boardGetInputsNum() && (configGetInputType(index) == IoType::IoAnalog)) {
-    return analogRead(BoardInputs[index]) * 10.0 / (pow(2, ioResolution()) - 1); // 0 - 10v
+    return analogRead(BoardInputs[index]) * 10.0 / ioSampleMax(); // 0 - 10v
   }
 
   return 0;
@@ -1551,6 +2585,9 @@ bool Opta::ioGetDigitalOutput(size_t index) {
 
 void Opta::ioSetDigitalOuput(size_t index, bool on) {
   if (index < boardGetOutputsNum()) {
+    if (_ioDigitalOutputs[index] != on) {
+      _ioChangedOutputs |= 1ULL << index;
+    }
     _ioDigitalOutputs[index] = on;
     digitalWrite(BoardOutputs[index], on ? 1 : 0);
     digitalWrite(BoardOutputsLeds[index], on ? 1 : 0);
@@ -1630,15 +2667,26 @@ bool Opta::networkSetup() {
 }
 
 bool Opta::networkLoop() {
+  // reconnection is done by network thread, do not touch network while it works
+  if (_networkReconnect.connecting()) {
+    bool ret;
+    if (!_networkReconnect.finished(ret)) {
+      return running();
+    }
+
+    if (networkIsEthernet()) {
+      networkConnectEthernetResult(ret);
+    } else {
+      networkConnectStandardResult(ret);
+    }
+  }
+
   if (networkIsEthernet()) {
-    // mauvaise condition
-    if (!networkIsConnected() && networkPoll(_networkLastRetry)) {
-      _networkLastRetry = now();
-      if (networkIsConnected()) {
-        Ethernet.maintain();
-      } else {
-        networkConnectEthernet();
-      }
+    if (!networkIsConnected() && _networkReconnect.due(now())) {
+      serialLine(label_network_eth);
+      networkConnectAsync();
+
+      return running();
     }
     if (!networkIsConnected() && Ethernet.linkStatus() == LinkON) {
       serialInfo(label_network_eth_plug);
@@ -1649,13 +2697,16 @@ bool Opta::networkLoop() {
       networkSetConnected(false);
     }
     if (networkIsConnected() && Ethernet.linkStatus() == LinkON) {
-      _networkLastRetry = 0;
+      _networkReconnect.connected();
       networkSetConnected(true);
     }
   } else if (networkIsStandard()) {
-    if (!networkIsConnected() && networkPoll(_networkLastRetry)) {
-      _networkLastRetry = now();
-      networkConnectStandard();
+    if (!networkIsConnected() && _networkReconnect.due(now())) {
+      serialLine(label_network_sta);
+      networkConnectAsync();
+    }
+    if (networkIsConnected()) {
+      _networkReconnect.connected();
     }
   } else if (networkIsAccessPoint()) {
     if (_networkAccessPointStatus != WiFi.status()) {
@@ -1729,18 +2780,26 @@ bool Opta::networkIsEthernet() {
 void Opta::networkConnectEthernet() {
   serialLine(label_network_eth);
 
-  int ret = 0;
   ledSetFreeze(true);
+  bool ret = networkBeginEthernet();
+  ledSetFreeze(false);
+
+  networkConnectEthernetResult(ret);
+}
+
+bool Opta::networkBeginEthernet() {
+  // blocking, called from setup or from network thread
   if (configGetNetworkDhcp()) {
-    serialInfo(label_network_mode + String("DHCP"));
-    ret = Ethernet.begin(nullptr, networkTimeout(), 4000);
-  } else {
-    serialInfo(label_network_mode + String("Static IP"));
-    ret = Ethernet.begin(nullptr, networkParseIp(configGetNetworkIp()), networkParseIp(configGetNetworkDns()), networkParseIp(configGetNetworkGateway()), networkParseIp(configGetNetworkSubnet()), networkTimeout(), 4000);
+    return Ethernet.begin(nullptr, networkTimeout(), 4000) != 0;
   }
-  ledSetFreeze(false);
 
-  if (ret == 0) {
+  return Ethernet.begin(nullptr, networkParseIp(configGetNetworkIp()), networkParseIp(configGetNetworkDns()), networkParseIp(configGetNetworkGateway()), networkParseIp(configGetNetworkSubnet()), networkTimeout(), 4000) != 0;
+}
+
+void Opta::networkConnectEthernetResult(bool ret) {
+  serialInfo(label_network_mode + String(configGetNetworkDhcp() ? "DHCP" : "Static IP"));
+
+  if (!ret) {
     networkSetConnected(false);
     serialWarn(label_network_eth_fail);
     if (Ethernet.linkStatus() == LinkOFF) {
@@ -1763,19 +2822,33 @@ void Opta::networkConnectStandard() {
   netApPass.toCharArray(pass, sizeof(pass));
 
   serialInfo(label_network_ssid + netApSsid + " / " + netApPass);
-  if (configGetNetworkDhcp()) {
-    serialInfo(label_network_mode + String("DHCP"));
-  } else {
-    serialInfo(label_network_mode + String("Static IP"));
-    WiFi.config(networkParseIp(configGetNetworkIp()), networkParseIp(configGetNetworkDns()), networkParseIp(configGetNetworkGateway()), networkParseIp(configGetNetworkSubnet()));
-  }
 
   ledSetFreeze(true);
-  WiFi.setTimeout(networkTimeout());
-  int ret = WiFi.begin(ssid, pass);
+  bool ret = networkBeginStandard();
   ledSetFreeze(false);
 
-  if (ret != WL_CONNECTED) {
+  networkConnectStandardResult(ret);
+}
+
+bool Opta::networkBeginStandard() {
+  // blocking, called from setup or from network thread
+  char ssid[32];
+  char pass[32];
+  configGetNetworkSsid().toCharArray(ssid, sizeof(ssid));
+  configGetNetworkPassword().toCharArray(pass, sizeof(pass));
+
+  if (!configGetNetworkDhcp()) {
+    WiFi.config(networkParseIp(configGetNetworkIp()), networkParseIp(configGetNetworkDns()), networkParseIp(configGetNetworkGateway()), networkParseIp(configGetNetworkSubnet()));
+  }
+  WiFi.setTimeout(networkTimeout());
+
+  return WiFi.begin(ssid, pass) == WL_CONNECTED;
+}
+
+void Opta::networkConnectStandardResult(bool ret) {
+  serialInfo(label_network_mode + String(configGetNetworkDhcp() ? "DHCP" : "Static IP"));
+
+  if (!ret) {
     serialWarn(label_network_sta_fail);
     networkSetConnected(false);
   } else {
@@ -1784,6 +2857,31 @@ void Opta::networkConnectStandard() {
   }
 }
 
+void Opta::networkConnectAsync() {
+  if (!_networkThreaded) {
+    _networkThreaded = true;
+
+    static rtos::Thread thread(osPriorityNormal, 4096);
+    thread.start([]() {
+      // rtos::Thread.start() requires a static callback
+      if (instance) {
+        instance->networkConnectThread();
+      }
+    });
+  }
+
+  _networkReconnect.start(now());
+  _networkConnectFlags.set(1);
+}
+
+void Opta::networkConnectThread() {
+  while (true) {
+    _networkConnectFlags.wait_any(1);
+
+    _networkReconnect.finish(networkIsEthernet() ? networkBeginEthernet() : networkBeginStandard());
+  }
+}
+
 /**
  * Time
  */
@@ -1811,7 +2909,14 @@ bool Opta::timeLoop(bool startBenchmark) {
 
     _timeBenchmarkTime = now();
     _timeBenchmarkCount = _timeBenchmarkRepeat = _timeBenchmarkSum = 0;
-  } else if (_timeBenchmarkTime > 0) {
+  }
+
+  return running();
+}
+
+void Opta::timeBenchmark() {
+  // count loop passes, not timeLoop() calls as it is not run on every pass
+  if (_timeBenchmarkTime > 0) {
     _timeBenchmarkCount++;
     if (now() - _timeBenchmarkTime > 1000) {
       serialInfo(label_time_loop_line + String(_timeBenchmarkCount));
@@ -1828,8 +2933,6 @@ bool Opta::timeLoop(bool startBenchmark) {
       }
     }
   }
-
-  return running();
 }
 
 const char *Opta::timeServer() {
@@ -1891,12 +2994,21 @@ bool Opta::rs485Setup() {
     return running();
   }
 
-  rs485Prepare();
-  RS485.begin(OPTA2IOT_RS485_BAUDRATE);
+  rs485Prepare(true);
+  RS485.begin(configGetRs485Baudrate(), rs485Config());
   RS485.receive();
 
   _rs485Enabled = true;
 
+  // received bytes are timed as they arrive, whatever loop is doing
+  static rtos::Thread thread(osPriorityAboveNormal, 1024);
+  thread.start([]() {
+    // rtos::Thread.start() requires a static callback
+    if (instance) {
+      instance->rs485ReceiveThread();
+    }
+  });
+
   watchdogPing();
 
   return running();
@@ -1906,72 +3018,258 @@ bool Opta::rs485IsEnabled() {
   return _rs485Enabled;
 }
 
-void Opta::rs485Prepare() {
-    constexpr auto bitduration{ 1.f / OPTA2IOT_RS485_BAUDRATE };
-    constexpr auto wordlen{ 9.6f };  // required for modbus, OR 10.0f depending on the channel configuration for rs485
-    constexpr auto preDelayBR{ bitduration * wordlen * 3.5f * 1e6 };
-    constexpr auto postDelayBR{ bitduration * wordlen * 3.5f * 1e6 };
-    RS485.setDelays(preDelayBR, postDelayBR);
+void Opta::rs485Prepare(bool silence) {
+  serialInfo(label_rs485_timing + String(rs485CharTime()) + ", " + String(rs485T15()) + ", " + String(rs485T35()));
+
+  rs485SetDelays(silence);
+}
+
+void Opta::rs485SetDelays(bool silence) {
+  // Modbus library sends (RTU server replies, blocking client requests) wait t3.5 before sending,
+  // sends that check bus silence with rs485IsSilent() do not, driver always waits for last character to leave
+  RS485.setDelays(silence ? 0 : rs485T35(), rs485CharTime());
+}
+
+uint16_t Opta::rs485Config() {
+  switch (configGetRs485Parity()) {
+    case 1:
+      return SERIAL_8E1;
+    case 2:
+      return SERIAL_8O1;
+    default:
+      return modbusIsRtu() ? SERIAL_8N2 : SERIAL_8N1;  // Modbus keeps 11 bits characters
+  }
+}
+
+uint32_t Opta::rs485CharTime() {
+  // start, 8 data, parity or second stop for Modbus, stop
+  const uint32_t bits = configGetRs485Parity() > 0 || modbusIsRtu() ? 11 : 10;
+
+  return (bits * 1000000UL + configGetRs485Baudrate() - 1) / configGetRs485Baudrate();
+}
+
+uint32_t Opta::rs485T15() {
+  // Modbus over serial line: fixed values above 19200 bauds
+  return configGetRs485Baudrate() > 19200 ? 750 : (rs485CharTime() * 3 + 1) / 2;
+}
+
+uint32_t Opta::rs485T35() {
+  return configGetRs485Baudrate() > 19200 ? 1750 : (rs485CharTime() * 7 + 1) / 2;
+}
+
+void Opta::rs485SetActivity() {
+  _rs485Activity = micros();
+}
+
+bool Opta::rs485IsSilent(uint32_t gap) {
+  return micros() - _rs485Activity >= gap;
+}
+
+bool Opta::rs485Loop() {
+  if (!rs485IsEnabled()) {
+    return running();
+  }
+
+  // callbacks of sent messages run in loop, not in send thread
+  Rs485Message done;
+  while (_rs485TxDone.pop(done)) {
+    done.callback(true, done.context);
+  }
+
+  rs485BridgeLoop();
+
+  return running();
+}
+
+void Opta::rs485ReceiveThread() {
+  // UART interrupt fills driver buffer, bytes are moved here into frames
+  while (true) {
+    _rs485RxLock.lock();
+    if (_rs485Rx.drain(RS485, micros(), rs485CharTime(), rs485T35()) > 0) {
+      rs485SetActivity();
+    }
+    _rs485RxLock.unlock();
+
+    delay(OPTA2IOT_RS485_POLL);
+  }
+}
+
+void Opta::rs485SetFraming(byte framing, uint32_t parameter) {
+  serialInfo(label_rs485_framing + String(framing) + "/" + String(parameter));
+
+  _rs485RxLock.lock();
+  _rs485Rx.begin(framing, parameter);
+  _rs485RxLock.unlock();
 }
 
 bool Opta::rs485Incoming() {
-  if (rs485IsEnabled()) {
-    int aval = RS485.available();
-    if (aval > 0) {
-      delay(1); // wait to receive full message
-      //serialInfo("Receiving RS485 message of length " + String(aval));
-
-      char r_message[30];
-      int r_index = 0;
-      while (1) {
-        int r_value = RS485.read();
-        if (r_value == -1) {
-          r_message[r_index] = '\0';
-          break;
-        }
-        r_message[r_index] = (char) (byte) r_value;
-        r_index++;
-      }
-      watchdogPing();
+  return rs485IsEnabled() && !rs485IsBridge() && !_rs485Rx.empty();
+}
+
+bool Opta::rs485IsBridge() {
+  return rs485IsEnabled() && configGetRs485Bridge() && mqttIsEnabled();
+}
 
-      if (r_index) {
-        _rs485Received = String(r_message);
+void Opta::rs485BridgeLoop() {
+  size_t count = _rs485Rx.size();
+  if (!rs485IsBridge() || !mqttIsConnected() || count == 0) {
+    _rs485BridgeTime = 0;
 
-        return true;
-      }
+    return;
+  }
+
+  // batch is published once window is elapsed, or before frames queue is full
+  if (_rs485BridgeTime == 0) {
+    _rs485BridgeTime = now() | 1;
+  }
+  if (now() - _rs485BridgeTime < configGetRs485Window() && count < OPTA2IOT_RS485_FRAMES / 2) {
+    return;
+  }
+  _rs485BridgeTime = 0;
+
+  // frames are written from receive buffer with their delimiter or length, as received on bus
+  const byte framing = _rs485Rx.framing();
+  const size_t extra = framing == Rs485Framing::Rs485FramingGap ? 0 : 1;
+  Rs485Frame frame;
+  size_t length = 0;
+  for (size_t i = 0; i < count; i++) {
+    _rs485Rx.peek(frame.data, frame.length, i);
+    length += frame.length + extra;
+  }
+
+  mqttClient.beginMessage(mqttTopic(MqttTopicRs485Rx), length);
+  for (size_t i = 0; i < count; i++) {
+    _rs485Rx.peek(frame.data, frame.length, i);
+    if (framing == Rs485Framing::Rs485FramingLength) {
+      mqttClient.write((uint8_t)frame.length);
+    }
+    mqttClient.write(frame.data, frame.length);
+    if (framing == Rs485Framing::Rs485FramingDelimiter) {
+      mqttClient.write((uint8_t)_rs485Rx.parameter());
     }
   }
+  mqttClient.endMessage();
 
-  return false;
+  for (size_t i = 0; i < count; i++) {
+    rs485Release();
+  }
+}
+
+bool Opta::rs485BridgeHold() {
+  // MQTT messages stay in broker connection while send queue is full, for a limited time to keep connection alive
+  if (!rs485IsBridge() || (OPTA2IOT_RS485_TX_SIZE - _rs485TxBytes.size() >= OPTA2IOT_RS485_BRIDGE_ROOM
+      && _rs485TxQueue.size() < OPTA2IOT_RS485_TX_QUEUE)) {
+    _rs485BridgeHold = 0;
+
+    return false;
+  }
+
+  if (_rs485BridgeHold == 0) {
+    _rs485BridgeHold = now() | 1;
+  }
+
+  return now() - _rs485BridgeHold < OPTA2IOT_RS485_BRIDGE_HOLD;
+}
+
+bool Opta::rs485Peek(Rs485Frame &frame) {
+  return _rs485Rx.peek(frame.data, frame.length);
+}
+
+void Opta::rs485Release() {
+  _rs485Rx.release();
 }
 
 String Opta::rs485Received() {
   String ret = "";
-  if (_rs485Received.length()) {
-    ret = _rs485Received;
-    _rs485Received = "";
+  Rs485Frame frame;
+  if (rs485Peek(frame)) {
+    ret.reserve(frame.length);
+    for (size_t i = 0; i < frame.length; i++) {
+      ret += (char)frame.data[i];
+    }
+    rs485Release();
   }
 
   return ret;
 }
 
+uint32_t Opta::rs485GetOverruns() {
+  return _rs485Rx.overruns();
+}
+
 bool Opta::rs485Send(String msg) {
-  if (rs485IsEnabled() && !_rs485Sending) {
-    //serialInfo("Sending RS485 message");
+  return rs485Send((const uint8_t *)msg.c_str(), msg.length());
+}
 
-    _rs485Sending = true;
-    RS485.noReceive();
-    RS485.beginTransmission();
-    RS485.print(msg);
-    RS485.endTransmission();
-    RS485.receive();
+bool Opta::rs485Send(const uint8_t *data, size_t length, Rs485Callback callback, void *context) {
+  if (!rs485IsEnabled() || length == 0 || length > 0xFFFF) {
+    return false;
+  }
 
-    _rs485Sending = false;
+  if (!_rs485Threaded) {
+    _rs485Threaded = true;
 
-    return true;
+    static rtos::Thread thread(osPriorityNormal, 2048);
+    thread.start([]() {
+      // rtos::Thread.start() requires a static callback
+      if (instance) {
+        instance->rs485SendThread();
+      }
+    });
   }
 
-  return false;
+  _rs485TxLock.lock();
+  bool ret = OPTA2IOT_RS485_TX_SIZE - _rs485TxBytes.size() >= length && _rs485TxQueue.size() < OPTA2IOT_RS485_TX_QUEUE;
+  if (ret) {
+    for (size_t i = 0; i < length; i++) {
+      _rs485TxBytes.push(data[i]);
+    }
+    _rs485TxQueue.push({ (uint16_t)length, callback, context });  // message is complete once queued
+  }
+  _rs485TxLock.unlock();
+
+  if (ret) {
+    _rs485TxFlags.set(1);
+  }
+
+  return ret;
+}
+
+size_t Opta::rs485Pending() {
+  return _rs485TxQueue.size();
+}
+
+void Opta::rs485SendThread() {
+  uint8_t chunk[64];
+  while (true) {
+    _rs485TxFlags.wait_any(1);
+
+    Rs485Message message;
+    while (_rs485TxQueue.pop(message)) {
+      // half duplex, wait for end of received frame
+      while (!rs485IsSilent(rs485T35())) {
+        delay(1);
+      }
+
+      RS485.noReceive();
+      RS485.beginTransmission();
+      for (size_t sent = 0; sent < message.length;) {
+        size_t length = 0;
+        while (length < sizeof(chunk) && sent + length < message.length && _rs485TxBytes.pop(chunk[length])) {
+          length++;
+        }
+        RS485.write(chunk, length);
+        sent += length;
+      }
+      RS485.endTransmission();
+      RS485.receive();
+      rs485SetActivity();
+
+      if (message.callback) {
+        _rs485TxDone.push(message);
+      }
+    }
+  }
 }
 
 /*
@@ -1995,8 +3293,8 @@ bool Opta::modbusSetup() {
       serialInfo(label_modbus_server);
       serialInfo(label_modbus_rtu);
 
-      rs485Prepare();
-      if (!modbusRtuServer.begin(configGetModbusId(), OPTA2IOT_RS485_BAUDRATE, SERIAL_8E1)) {
+      rs485Prepare(false);
+      if (!modbusRtuServer.begin(configGetModbusId(), configGetRs485Baudrate(), rs485Config())) {
         return stop(label_modbus_start_error);
       }
 
@@ -2007,23 +3305,42 @@ bool Opta::modbusSetup() {
       serialInfo(label_modbus_server);
       serialInfo(label_modbus_tcp);
 
+      // libmodbus context only holds tables, masters are served by modbusTcpLoop()
       if (!modbusTcpServer.begin(configGetModbusId())) {
         return stop(label_modbus_start_error);
       }
 
       modbusSetRegisters();
 
+      serialInfo(label_modbus_tcp_port + String(configGetModbusPort()));
+      if (networkIsEthernet()) {
+        _modbusEthernetServer = EthernetServer(configGetModbusPort());
+        _modbusEthernetServer.begin();
+      } else {
+        _modbusWifiServer = WiFiServer(configGetModbusPort());
+        _modbusWifiServer.begin();
+      }
+
     break;
 
     case ModbusType::ModbusRtuClient:
       serialInfo(label_modbus_client);
       serialInfo(label_modbus_rtu);
 
-      rs485Prepare();
-      if (!modbusRtuClient.begin(OPTA2IOT_RS485_BAUDRATE, SERIAL_8E1)) {
+      rs485Prepare(false);
+      if (!modbusRtuClient.begin(configGetRs485Baudrate(), rs485Config())) {
         return stop(label_modbus_start_error);
       }
 
+      modbusScanSetup();
+    break;
+
+    case ModbusType::ModbusTcpClient:
+      serialInfo(label_modbus_client);
+      serialInfo(label_modbus_tcp);
+
+      // connection to server is opened by modbusClientLoop()
+      modbusScanSetup();
     break;
 
     default:
@@ -2038,20 +3355,24 @@ bool Opta::modbusSetup() {
 
 bool Opta::modbusLoop() {
   if (modbusIsServer()) {
-    if ((now() - _modbusLastPoll) > OPTA2IOT_MODBUS_POLL) {
+    if (!modbusIsRtu()) {
+      modbusTcpLoop();
+      modbusSyncCoils();
+    }
+
+    if ((now() - _modbusLastPoll) >= OPTA2IOT_MODBUS_POLL) {
       if (modbusIsRtu()) {
         modbusRtuServer.poll();
-
-        // check if Holding Registers change
-        if (modbusRtuServer.holdingRegisterRead(0) != modbusRtuServer.inputRegisterRead(0)) {
-          serialWarn(label_modbus_registers_change);
-
-          // ... todo
-        }
+        modbusSyncCoils();
       }
 
+      // check if Holding Registers change
+      modbusReceive();
+
       _modbusLastPoll = now();
     }
+  } else if (modbusIsEnabled()) {
+    modbusClientLoop();
   }
 
   return true;
@@ -2069,254 +3390,985 @@ bool Opta::modbusIsServer() {
   return configGetModbusType() == ModbusType::ModbusRtuServer || configGetModbusType() == ModbusType::ModbusTcpServer;
 }
 
-void Opta::modbusSetRegisters() {
-  if (modbusIsServer()) {
-    size_t i = 0;
-    size_t index = 0;
-
-    // Inputs
-    const size_t inputsNum  = boardGetInputsNum();
-    // start + num + type + value
-    const size_t inputsLen  = 1 + 1 + 2 * inputsNum;
-
-    // Outputs
-    const size_t outputsNum  = boardGetOutputsNum();
-    // start + num + type + value
-    const size_t outputsLen  = 1 + 1 + 2 * outputsNum;
-
-    // Device
-    const char *deviceId = configGetDeviceId().c_str();
-    const char *deviceUser = configGetDeviceUser().c_str();
-    const char *devicePassword = configGetDevicePassword().c_str();
-    // start + id len + id + user len + user + password len + password + time offset sign + time offset
-    const size_t deviceLen = 1 + 1 + strlen(deviceId) + 1 + strlen(deviceUser) + 1 + strlen(devicePassword) + 1 + 1;
-
-    // Network
-    IPAddress networkIp = networkParseIp(configGetNetworkIp());
-    IPAddress networkGateway = networkParseIp(configGetNetworkGateway());
-    IPAddress networkSubnet = networkParseIp(configGetNetworkSubnet());
-    IPAddress networkDns = networkParseIp(configGetNetworkDns());
-    const char *networkSsid = configGetNetworkSsid().c_str();
-    const char *networkPassword = configGetNetworkPassword().c_str();
-    // start + ip + gateway + subnet + dns + dhcp + wifi + ssid len + ssid + password len password
-    const size_t networkLen = 1 + 4 + 4 + 4 + 4 + 1 + 1 + 1 + strlen(networkSsid) + 1 + strlen(devicePassword);
-
-    // MQTT
-    IPAddress mqttIp = networkParseIp(configGetMqttIp());
-    const char *mqttUser = configGetMqttUser().c_str();
-    const char *mqttPassword = configGetMqttPassword().c_str();
-    const char *mqttBase = configGetMqttBase().c_str();
-    // start + ip + port + user len + user + password len + password + base len + base + interval
-    const size_t mqttLen = 1 + 4 + 1 + 1 + strlen(mqttUser) + 1 + strlen(mqttPassword) + 1 + strlen(mqttBase) + 1;
-
-    // Sum
-    const size_t fullLen = 29 + inputsLen + outputsLen + deviceLen + networkLen + mqttLen + 1;
-
-    int reg[2000];
-
-    reg[0] = fullLen; // full length of holding registers
-    reg[1] = 20; // Commands length, start at 10 with fix length of 20
-    reg[2] = inputsLen; // Inputs length
-    reg[3] = outputsLen; // Outputs length
-    reg[4] = deviceLen; // Device length
-    reg[5] = networkLen; // Network length
-    reg[6] = mqttLen; // Mqtt length
-
-    // Command
-    reg[10] = 0; // A part always start with 0
-    reg[11] = 0; // Perfom a device Reboot. always 0 here
-    reg[12] = 0; // Perfom a device Reset. always 0 here
-    reg[13] = 0; // Perfom a device Time Update. always 0 here
-
-    index = 30;
-
-    // Inputs
-    reg[index++] = 0; // A part always start with 0
-    reg[index++] = inputsNum; // Inputs num
-    for (i = 0; i < inputsNum; i++) {
-        reg[index++] = configGetInputType(i); // Input type
-        if (configGetInputType(i) == IoType::IoAnalog) {
-          reg[index++] = ioGetAnalogInput(i) * 1000; // Input analog value in mV
-        } else {
-          reg[index++] = ioGetDigitalInput(i) ? 1 : 0; // Input digital value
-        }
-    }
-
-    // Outputs
-    reg[index++]= 0; // A part always start with 0
-    reg[index++] = outputsNum; // Outputs num
-    for (i = 0; i < outputsNum; i++) {
-        reg[index++] = IoType::IoDigital; // Output type (for now ony digital is supported)
-        reg[index++] = ioGetDigitalOutput(i); // Output state
-
-        modbusSetCoil(i, ioGetDigitalOutput(i));
-    }
+void Opta::modbusRestart() {
+  if (modbusIsEnabled() && !modbusIsServer()) {
+    modbusScanSetup();
 
-    // Device
-    reg[index++] = 0; // A part always start with 0
-    reg[index++] = strlen(deviceId); // Device id length
-    for (i = 0; i < strlen(deviceId); i++) {
-      reg[index++] = deviceId[i]; // Device id
-    }
-    reg[index++] = strlen(deviceUser); // Device user length
-    for (i = 0; i < strlen(deviceUser); i++) {
-      reg[index++] = deviceUser[i]; // Device user
-    }
-    reg[index++] = strlen(devicePassword); // Device password length
-    for (i = 0; i < strlen(devicePassword); i++) {
-      reg[index++] = devicePassword[i]; // Device password
-    }
-    reg[index++] = configGetTimeOffset() >= 0 ? 1 : 0; // Device positive time offset
-    reg[index++] = abs(configGetTimeOffset()); // Device abolute time offset
+    return;
+  }
 
-    // Network
-    reg[index++]= 0; // A part always start with 0
-    for (i = 0; i < 4; i++) {
-      reg[index++] = networkIp[i]; // Network IP (chunk in 4)
-    }
-    for (i = 0; i < 4; i++) {
-      reg[index++] = networkGateway[i]; // Network gateway IP (chunk in 4)
-    }
-    for (i = 0; i < 4; i++) {
-      reg[index++] = networkSubnet[i]; // Network subnet IP (chunk in 4)
+  // only server device ID can change without reboot
+  _modbusRegistersNum = 0;  // server tables are configured again
+  if (configGetModbusType() == ModbusType::ModbusRtuServer) {
+    serialInfo(label_config_set_modbusid + String(configGetModbusId()));
+    modbusRtuServer.end();
+    if (!modbusRtuServer.begin(configGetModbusId(), configGetRs485Baudrate(), rs485Config())) {
+      serialWarn(label_modbus_start_error);
     }
-    for (i = 0; i < 4; i++) {
-      reg[index++] = networkDns[i]; // Network DNS IP (chunk in 4)
-    }
-    reg[index++] = configGetNetworkDhcp() ? 1 : 0; // Network enable DHCP
-    reg[index++] = configGetNetworkWifi() ? 1 : 0; // Network enable Wifi
-    reg[index++] = strlen(networkSsid); // Network Wifi AP SSID length
-    for (i = 0; i < strlen(networkSsid); i++) {
-      reg[index++] = networkSsid[i]; // Network Wifi AP SSID
-    }
-    reg[index++] = strlen(networkPassword); // Network Wifi AP password length
-    for (i = 0; i < strlen(networkPassword); i++) {
-      reg[index++] = networkPassword[i]; // Network Wifi AP password
+  } else if (configGetModbusType() == ModbusType::ModbusTcpServer) {
+    serialInfo(label_config_set_modbusid + String(configGetModbusId()));
+    modbusTcpServer.end();
+    if (!modbusTcpServer.begin(configGetModbusId())) {
+      serialWarn(label_modbus_start_error);
     }
+  }
+}
 
-    // MQTT
-    reg[index++] = 0; // A part always start with 0
-    for (i = 0; i < 4; i++) {
-      reg[index++] = mqttIp[i]; // MQTT server IP (chunk in 4)
-    }
-    reg[index++] = configGetMqttPort(); // MQTT server port
-    reg[index++] = strlen(mqttUser); // MQTT user length
-    for (i = 0; i < strlen(mqttUser); i++) {
-      reg[index++] = mqttUser[i]; // MQTT user
-    }
-    reg[index++] = strlen(mqttPassword); // MQTT password length
-    for (i = 0; i < strlen(mqttPassword); i++) {
-      reg[index++] = mqttPassword[i]; // MQTT password
-    }
-    reg[index++] = strlen(mqttBase); // MQTT base topic length
-    for (i = 0; i < strlen(mqttBase); i++) {
-      reg[index++] = mqttBase[i]; // MQTT base topic
-    }
-    reg[index++] = configGetMqttInterval(); // MQTT update interval
+void Opta::modbusSetRegisters() {
+  if (!modbusIsServer()) {
+    return;
+  }
 
-    // Last Register to total length
-    reg[index++] = fullLen; // Must be the same as index 0
+  size_t index = modbusBuildRegisters();
 
+  // server tables are only reallocated when size changes,
+  // Holding Registers have full capacity so a master can write a larger image
+  if (index != _modbusRegistersNum) {
+    _modbusRegistersNum = index;
     if (modbusIsRtu()) {
-      modbusRtuServer.configureCoils(0x00, outputsNum);
-      modbusRtuServer.configureDiscreteInputs(0x00, inputsNum);
+      modbusRtuServer.configureCoils(0x00, boardGetOutputsNum());
+      modbusRtuServer.configureDiscreteInputs(0x00, boardGetInputsNum());
       modbusRtuServer.configureInputRegisters(0x00, index);
-      modbusRtuServer.configureHoldingRegisters(0x00, index);
+      modbusRtuServer.configureHoldingRegisters(0x00, OPTA2IOT_MODBUS_REGISTERS);
     } else {
-      modbusTcpServer.configureCoils(0x00, outputsNum);
-      modbusTcpServer.configureDiscreteInputs(0x00, inputsNum);
+      modbusTcpServer.configureCoils(0x00, boardGetOutputsNum());
+      modbusTcpServer.configureDiscreteInputs(0x00, boardGetInputsNum());
       modbusTcpServer.configureInputRegisters(0x00, index);
-      modbusTcpServer.configureHoldingRegisters(0x00, index);
+      modbusTcpServer.configureHoldingRegisters(0x00, OPTA2IOT_MODBUS_REGISTERS);
     }
+  }
 
-    for (i = 0; i < index; i++) {
-      modbusSetHoldingRegister(i, reg[i]);
-      modbusSetInputRegister(i, reg[i]);
-    }
+  modbusMirror(0, index);
+
+  for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+    modbusSetCoil(i, ioGetDigitalOutput(i));
   }
 }
 
-void Opta::modbusSetHoldingRegister(size_t offset, int value) {
-  if (modbusIsServer()) {
-    if (modbusIsRtu()) {
-      modbusRtuServer.holdingRegisterWrite(offset, value);
+size_t Opta::modbusBuildRegisters() {
+  // registers image is built in place, lengths are known once parts are written
+  uint16_t *reg = _modbusRegisters;
+  const size_t max = OPTA2IOT_MODBUS_REGISTERS - 1;  // keep room for last register
+  size_t index = 0;
+  size_t start = 0;
+  size_t i = 0;
+
+  auto push = [&](uint16_t value) {
+    if (index < max) {
+      reg[index++] = value;
+    }
+  };
+  auto text = [&](const String &value) {
+    push(value.length());  // length, then one char per register
+    for (size_t j = 0; j < value.length(); j++) {
+      push(value[j]);
+    }
+  };
+  auto ip = [&](const String &value) {
+    IPAddress address = networkParseIp(value);
+    for (size_t j = 0; j < 4; j++) {
+      push(address[j]);  // IP (chunk in 4)
+    }
+  };
+
+  memset(reg, 0, ModbusInputsStart * sizeof(uint16_t));
+
+  // Command
+  reg[ModbusLengthStart + 1] = ModbusCommandsLength; // Commands length, start at 10 with fix length of 20
+  reg[ModbusCommandsStart] = 0; // A part always start with 0
+  reg[ModbusCommandsStart + 1] = 0; // Perfom a device Reboot. always 0 here
+  reg[ModbusCommandsStart + 2] = 0; // Perfom a device Reset. always 0 here
+  reg[ModbusCommandsStart + 3] = 0; // Perfom a device Time Update. always 0 here
+
+  index = ModbusInputsStart;
+
+  // Inputs
+  start = index;
+  push(0); // A part always start with 0
+  push(boardGetInputsNum()); // Inputs num
+  for (i = 0; i < boardGetInputsNum(); i++) {
+    push(configGetInputType(i)); // Input type
+    if (configGetInputType(i) == IoType::IoAnalog) {
+      push(ioGetAnalogInput(i) * 1000); // Input analog value in mV
     } else {
-      modbusTcpServer.holdingRegisterWrite(offset, value);
+      push(ioGetDigitalInput(i) ? 1 : 0); // Input digital value
     }
   }
-}
+  reg[ModbusLengthStart + 2] = index - start; // Inputs length
+
+  // Outputs
+  start = index;
+  push(0); // A part always start with 0
+  push(boardGetOutputsNum()); // Outputs num
+  for (i = 0; i < boardGetOutputsNum(); i++) {
+    push(IoType::IoDigital); // Output type (for now ony digital is supported)
+    push(ioGetDigitalOutput(i)); // Output state
+  }
+  reg[ModbusLengthStart + 3] = index - start; // Outputs length
+
+  // Device
+  start = index;
+  push(0); // A part always start with 0
+  text(configGetDeviceId()); // Device id
+  text(configGetDeviceUser()); // Device user
+  text(configGetDevicePassword()); // Device password
+  push(configGetTimeOffset() >= 0 ? 1 : 0); // Device positive time offset
+  push(abs(configGetTimeOffset())); // Device abolute time offset
+  reg[ModbusLengthStart + 4] = index - start; // Device length
+
+  // Network
+  start = index;
+  push(0); // A part always start with 0
+  ip(configGetNetworkIp()); // Network IP
+  ip(configGetNetworkGateway()); // Network gateway IP
+  ip(configGetNetworkSubnet()); // Network subnet IP
+  ip(configGetNetworkDns()); // Network DNS IP
+  push(configGetNetworkDhcp() ? 1 : 0); // Network enable DHCP
+  push(configGetNetworkWifi() ? 1 : 0); // Network enable Wifi
+  text(configGetNetworkSsid()); // Network Wifi AP SSID
+  text(configGetNetworkPassword()); // Network Wifi AP password
+  reg[ModbusLengthStart + 5] = index - start; // Network length
+
+  // MQTT
+  start = index;
+  push(0); // A part always start with 0
+  ip(configGetMqttIp()); // MQTT server IP
+  push(configGetMqttPort()); // MQTT server port
+  text(configGetMqttUser()); // MQTT user
+  text(configGetMqttPassword()); // MQTT password
+  text(configGetMqttBase()); // MQTT base topic
+  push(configGetMqttInterval()); // MQTT update interval
+  reg[ModbusLengthStart + 6] = index - start; // Mqtt length
+
+  // Last Register to total length
+  reg[ModbusLengthStart] = index; // full length of holding registers
+  reg[index++] = reg[ModbusLengthStart]; // Must be the same as index 0
+
+  return index;
+}
+
+void Opta::modbusMirror(size_t start, size_t end, bool inputs) {
+  if (end > _modbusRegistersNum) {
+    end = _modbusRegistersNum;
+  }
+  if (start >= end) {
+    return;
+  }
 
-void Opta::modbusSetInputRegister(size_t offset, int value) {
-  if (modbusIsServer()) {
-    if (modbusIsRtu()) {
-      modbusRtuServer.inputRegisterWrite(offset, value);
-    } else {
-      modbusTcpServer.inputRegisterWrite(offset, value);
+  if (modbusIsRtu()) {
+    modbusRtuServer.writeHoldingRegisters(start, _modbusRegisters + start, end - start);
+    if (inputs) {
+      modbusRtuServer.writeInputRegisters(start, _modbusRegisters + start, end - start);
+    }
+  } else {
+    modbusTcpServer.writeHoldingRegisters(start, _modbusRegisters + start, end - start);
+    if (inputs) {
+      modbusTcpServer.writeInputRegisters(start, _modbusRegisters + start, end - start);
     }
   }
 }
 
-void Opta::modbusSetCoil(size_t coil, int value) {
-  if (modbusIsServer()) {
-    if (modbusIsRtu()) {
-      modbusRtuServer.coilWrite(coil, value > 0 ? 1 : 0);
-    } else {
-      modbusTcpServer.coilWrite(coil, value > 0 ? 1 : 0);
+void Opta::modbusReceive() {
+  // layout of Holding Registers as written by master, parts follow each other from Commands start
+  uint16_t lengths[1 + ModbusPartsNum];
+  size_t starts[ModbusPartsNum];
+  size_t offset = ModbusCommandsStart;
+  bool changed = false;
+  for (size_t i = 0; i <= ModbusPartsNum; i++) {
+    lengths[i] = modbusGetHoldingRegister(ModbusLengthStart + i);
+    changed |= lengths[i] != _modbusRegisters[ModbusLengthStart + i];
+    if (i > 0) {
+      starts[i - 1] = offset;
+      offset += lengths[i];
     }
-
-    // also update output value in Holding Registers
-    size_t reg = 30 + 1 + (2 * boardGetInputsNum()) + 2 + (2 * (coil + 1));
-    modbusSetInputRegister(reg, value);
   }
-}
 
-bool Opta::modbusGetCoil(uint8_t server, size_t coil) {
-  if (modbusIsEnabled() && !modbusIsServer()) {
-    if (modbusIsRtu()) {
-      return modbusRtuClient.coilRead(coil) == 1;
-    } else {
-      return modbusTcpClient.coilRead(coil) == 1;
+  bool complete = offset == lengths[0] && offset < OPTA2IOT_MODBUS_REGISTERS && modbusGetHoldingRegister(offset) == lengths[0];
+  size_t frameEnd = complete ? offset + 1 : 0;
+
+  // a part is changed when its first register is set to 1
+  bool parts[ModbusPartsNum] = { false };
+  if (complete) {
+    for (size_t i = 0; i < ModbusPartsNum; i++) {
+      parts[i] = lengths[i + 1] > 0 && modbusGetHoldingRegister(starts[i]) == 1;
+      changed |= parts[i];
     }
   }
 
-  return false;
-}
+  if (!changed) {
+    _modbusWriteTime = 0;
 
-bool Opta::modbusGetDiscreteInputs(int *response, uint8_t server, size_t length) {
-  if (!modbusIsEnabled() || modbusIsServer()) {
-    return false;
+    return;
   }
 
-  if (modbusIsRtu()) {
-    if (!modbusRtuClient.requestFrom(server, DISCRETE_INPUTS, 0x00, length)) {
-        serialWarn(String("Modbus: ") + modbusRtuClient.lastError());
-        return false;
+  // master may write registers with several requests
+  if (!complete) {
+    if (_modbusWriteTime == 0) {
+      _modbusWriteTime = now() | 1;
+    } else if (now() - _modbusWriteTime > OPTA2IOT_MODBUS_WRITE_TIMEOUT) {
+      serialWarn(label_modbus_registers_timeout);
+      modbusMirror(0, _modbusRegistersNum, false);
+      _modbusWriteTime = 0;
     }
 
-    size_t index = 0;
-    while (modbusRtuClient.available()) {
-        response[index++] = modbusRtuClient.read();
+    return;
+  }
+  _modbusWriteTime = 0;
+
+  serialLine(label_modbus_registers_change);
+
+  JsonDocument previous;
+  configToJson(previous, false);
+
+  bool commandReboot = false;
+  bool commandReset = false;
+  bool commandTime = false;
+  bool config = false;
+  size_t first = _modbusRegistersNum;  // first image register to mirror again
+  size_t imageStart = ModbusCommandsStart;
+  for (size_t i = 0; i < ModbusPartsNum; i++) {
+    if (parts[i]) {
+      serialInfo(label_modbus_registers_part + String(i));
+      if (i == ModbusPartCommands) {
+        commandReboot = lengths[1] > 1 && modbusGetHoldingRegister(starts[i] + 1) > 0;
+        commandReset = lengths[1] > 2 && modbusGetHoldingRegister(starts[i] + 2) > 0;
+        commandTime = lengths[1] > 3 && modbusGetHoldingRegister(starts[i] + 3) > 0;
+      } else if (modbusReceivePart(i, starts[i], starts[i] + lengths[i + 1])) {
+        config |= i != ModbusPartOutputs;
+        if (imageStart < first) {
+          first = imageStart;
+        }
+      } else {
+        serialWarn(label_modbus_registers_invalid + String(i));
+      }
     }
+    imageStart += _modbusRegisters[ModbusLengthStart + 1 + i];
   }
+  watchdogPing();
 
-  return true;
-}
-
-bool Opta::modbusGetRegisters(int *response, uint8_t type, uint8_t server, size_t start, size_t length) {
-  if (!modbusIsEnabled() || modbusIsServer()) {
-    return false;
-  }
+  if (config) {
+    configWriteToFile();
 
-  if (modbusIsRtu()) {
-    if (!modbusRtuClient.requestFrom(server, type, start, length)) {
-        serialWarn(String("Modbus: ") + modbusRtuClient.lastError());
-        return false;
+    byte scope = configDiff(previous);
+    if (scope & ConfigScopeReboot) {
+      commandReboot = true;
+    } else {
+      serialInfo(label_config_hot);
+      configApply(scope & ~ConfigScopeRegisters, previous);
     }
+  }
 
-    size_t index = 0;
-    while (modbusRtuClient.available()) {
-      response[index++] = modbusRtuClient.read();
-    }
+  // only changed parts of the image go back to Input Registers, Holding Registers written by master are restored
+  if (modbusBuildRegisters() != _modbusRegistersNum) {
+    modbusSetRegisters();
+  } else {
+    modbusMirror(ModbusLengthStart, ModbusCommandsStart);
+    modbusMirror(ModbusCommandsStart, frameEnd < first ? frameEnd : first, false);
+    modbusMirror(first, _modbusRegistersNum);
+  }
+
+  if (commandTime) {
+    serialInfo(label_modbus_command_time);
+    timeUpdate();
+  }
+  if (commandReset) {
+    serialInfo(label_modbus_command_reset);
+    reset();
+    commandReboot = true;
+  }
+  if (commandReboot) {
+    serialInfo(label_modbus_command_reboot);
+    reboot();
+  }
+}
+
+bool Opta::modbusReceivePart(byte part, size_t start, size_t end) {
+  // part is parsed register by register from server table, then applied only if valid
+  size_t index = start + 1;  // skip part flag
+  bool valid = true;
+  size_t i = 0;
+
+  auto next = [&]() -> uint16_t {
+    if (index >= end) {
+      valid = false;
+
+      return 0;
+    }
+
+    return modbusGetHoldingRegister(index++);
+  };
+  auto text = [&](size_t max) -> String {
+    String value;
+    uint16_t length = next();  // length, then one char per register
+    if (length > max) {
+      valid = false;
+
+      return value;
+    }
+    for (size_t j = 0; j < length; j++) {
+      uint16_t c = next();
+      if (c == 0 || c > 255) {
+        valid = false;
+      }
+      value += (char)c;
+    }
+
+    return value;
+  };
+  auto ip = [&]() -> String {
+    String value;
+    for (size_t j = 0; j < 4; j++) {
+      uint16_t chunk = next();  // IP (chunk in 4)
+      if (chunk > 255) {
+        valid = false;
+      }
+      value += (j > 0 ? "." : "") + String(chunk);
+    }
+
+    return value;
+  };
+
+  switch (part) {
+    case ModbusPartInputs: {
+      byte types[sizeof(ConfigRecord::inputs)];
+      if (next() != boardGetInputsNum()) {
+        return false;
+      }
+      for (i = 0; i < boardGetInputsNum(); i++) {
+        types[i] = next(); // Input type
+        next(); // Input value, read only
+        if (types[i] > IoType::IoPulse) {
+          valid = false;
+        }
+      }
+      if (!valid || index != end) {
+        return false;
+      }
+      for (i = 0; i < boardGetInputsNum(); i++) {
+        configSetInputType(i, types[i]);
+      }
+    } break;
+
+    case ModbusPartOutputs: {
+      bool states[sizeof(_ioDigitalOutputs)];
+      if (next() != boardGetOutputsNum()) {
+        return false;
+      }
+      for (i = 0; i < boardGetOutputsNum(); i++) {
+        next(); // Output type, read only
+        states[i] = next() > 0; // Output state
+      }
+      if (!valid || index != end) {
+        return false;
+      }
+      for (i = 0; i < boardGetOutputsNum(); i++) {
+        ioSetDigitalOuput(i, states[i]);
+        modbusSetCoil(i, states[i]);
+      }
+    } break;
+
+    case ModbusPartDevice: {
+      String id = text(sizeof(ConfigRecord::deviceId) - 1); // Device id
+      String user = text(sizeof(ConfigRecord::deviceUser) - 1); // Device user
+      String password = text(sizeof(ConfigRecord::devicePassword) - 1); // Device password
+      bool positive = next() > 0; // Device positive time offset
+      int offset = next(); // Device abolute time offset
+      if (!valid || index != end || id == "" || user == "" || offset > 24) {
+        return false;
+      }
+      configSetDeviceId(id);
+      configSetDeviceUser(user);
+      if (password != "") {  // keep previous password if none set
+        configSetDevicePassword(password);
+      }
+      configSetTimeOffset(positive ? offset : -offset);
+    } break;
+
+    case ModbusPartNetwork: {
+      String netIp = ip(); // Network IP
+      String gateway = ip(); // Network gateway IP
+      String subnet = ip(); // Network subnet IP
+      String dns = ip(); // Network DNS IP
+      bool dhcp = next() > 0; // Network enable DHCP
+      bool wifi = next() > 0; // Network enable Wifi
+      String ssid = text(sizeof(ConfigRecord::networkSsid) - 1); // Network Wifi AP SSID
+      String password = text(sizeof(ConfigRecord::networkPassword) - 1); // Network Wifi AP password
+      if (!valid || index != end) {
+        return false;
+      }
+      configSetNetworkIp(netIp);
+      configSetNetworkGateway(gateway);
+      configSetNetworkSubnet(subnet);
+      configSetNetworkDns(dns);
+      configSetNetworkDhcp(dhcp);
+      configSetNetworkWifi(wifi);
+      configSetNetworkSsid(ssid);
+      if (password != "" || ssid == "") {  // keep previous password if none set
+        configSetNetworkPassword(password);
+      }
+    } break;
+
+    case ModbusPartMqtt: {
+      String mqttIp = ip(); // MQTT server IP
+      uint16_t port = next(); // MQTT server port
+      String user = text(sizeof(ConfigRecord::mqttUser) - 1); // MQTT user
+      String password = text(sizeof(ConfigRecord::mqttPassword) - 1); // MQTT password
+      String base = text(sizeof(ConfigRecord::mqttBase) - 1); // MQTT base topic
+      int interval = next(); // MQTT update interval
+      if (!valid || index != end || port == 0) {
+        return false;
+      }
+      configSetMqttIp(mqttIp);
+      configSetMqttPort(port);
+      configSetMqttUser(user);
+      if (password != "" || user == "") {  // keep previous password if none set
+        configSetMqttPassword(password);
+      }
+      configSetMqttBase(base);
+      configSetMqttInterval(interval);
+    } break;
+
+    default:
+      return false;
+  }
+
+  return true;
+}
+
+void Opta::modbusSetDiscreteInput(size_t index, int value) {
+  if (modbusIsRtu()) {
+    modbusRtuServer.discreteInputWrite(index, value > 0 ? 1 : 0);
+  } else {
+    modbusTcpServer.discreteInputWrite(index, value > 0 ? 1 : 0);
+  }
+}
+
+void Opta::modbusSyncCoils() {
+  // coils are always written with outputs state, a difference comes from a master
+  for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+    int coil = modbusIsRtu() ? modbusRtuServer.coilRead(i) : modbusTcpServer.coilRead(i);
+    if (coil >= 0 && (coil > 0) != ioGetDigitalOutput(i)) {
+      serialInfo("Setting output " + String(i + 1) + " to " + String(coil));
+
+      ioSetDigitalOuput(i, coil > 0);
+      modbusSetCoil(i, coil);
+    }
+  }
+}
+
+void Opta::modbusTcpLoop() {
+  if (!networkIsConnected()) {
+    return;
+  }
+
+  modbusTcpAccept();
+
+  for (size_t i = 0; i < OPTA2IOT_MODBUS_CLIENTS; i++) {
+    if (_modbusConnections[i].client) {
+      modbusTcpProcess(_modbusConnections[i]);
+    }
+  }
+}
+
+void Opta::modbusTcpAccept() {
+  for (size_t i = 0; i < OPTA2IOT_MODBUS_CLIENTS; i++) {
+    ModbusConnection &conn = _modbusConnections[i];
+    if (conn.client) {
+      continue;
+    }
+
+    if (networkIsEthernet()) {
+      _modbusEthernetClients[i] = _modbusEthernetServer.accept();
+      if (!_modbusEthernetClients[i]) {
+        return;
+      }
+      conn.client = &_modbusEthernetClients[i];
+      serialInfo(label_modbus_tcp_accept + _modbusEthernetClients[i].remoteIP().toString());
+    } else {
+      _modbusWifiClients[i] = _modbusWifiServer.accept();
+      if (!_modbusWifiClients[i]) {
+        return;
+      }
+      conn.client = &_modbusWifiClients[i];
+      serialInfo(label_modbus_tcp_accept + _modbusWifiClients[i].remoteIP().toString());
+    }
+
+    conn.time = now();
+    conn.length = 0;
+  }
+}
+
+void Opta::modbusTcpProcess(ModbusConnection &conn) {
+  if (!conn.client->connected() || now() - conn.time > OPTA2IOT_MODBUS_TIMEOUT) {
+    modbusTcpClose(conn);
+
+    return;
+  }
+
+  int available = conn.client->available();
+  size_t space = sizeof(conn.buffer) - conn.length;
+  if (available > 0 && space > 0) {
+    int read = conn.client->read(conn.buffer + conn.length, (size_t)available < space ? available : space);
+    if (read > 0) {
+      conn.length += read;
+      conn.time = now();
+    }
+  }
+
+  // pipelined requests are answered in order
+  for (size_t frames = 0; frames < OPTA2IOT_MODBUS_BURST; frames++) {
+    int size = ModbusTcp::frame(conn.buffer, conn.length);
+    if (size < 0) {
+      modbusTcpClose(conn);  // not Modbus protocol
+
+      return;
+    }
+    if (size == 0) {
+      break;
+    }
+
+    modbusTcpRequest(conn, conn.buffer, size);
+
+    conn.length -= size;
+    memmove(conn.buffer, conn.buffer + size, conn.length);
+  }
+}
+
+void Opta::modbusTcpRequest(ModbusConnection &conn, const uint8_t *request, size_t length) {
+  // server tables with their configured sizes
+  struct Tables {
+    Opta &opta;
+    size_t coilsNum() { return opta.boardGetOutputsNum(); }
+    size_t discreteInputsNum() { return opta.boardGetInputsNum(); }
+    size_t holdingRegistersNum() { return OPTA2IOT_MODBUS_REGISTERS; }
+    size_t inputRegistersNum() { return opta._modbusRegistersNum; }
+    long coilRead(int address) { return opta.modbusTcpServer.coilRead(address); }
+    long discreteInputRead(int address) { return opta.modbusTcpServer.discreteInputRead(address); }
+    long holdingRegisterRead(int address) { return opta.modbusTcpServer.holdingRegisterRead(address); }
+    long inputRegisterRead(int address) { return opta.modbusTcpServer.inputRegisterRead(address); }
+    void coilWrite(int address, uint8_t value) { opta.modbusTcpServer.coilWrite(address, value); }
+    void holdingRegisterWrite(int address, uint16_t value) { opta.modbusTcpServer.holdingRegisterWrite(address, value); }
+  } tables{ *this };
+
+  uint8_t response[ModbusTcp::AduMax];
+  conn.client->write(response, ModbusTcp::respond(tables, request, length, response));
+}
+
+void Opta::modbusTcpClose(ModbusConnection &conn) {
+  conn.client->stop();
+  conn.client = nullptr;
+  conn.length = 0;
+}
+
+void Opta::modbusSetRegister(size_t offset, uint16_t value) {
+  // only changed values reach server Input Registers
+  if (offset < _modbusRegistersNum && _modbusRegisters[offset] != value) {
+    _modbusRegisters[offset] = value;
+    modbusSetInputRegister(offset, value);
+  }
+}
+
+void Opta::modbusSetHoldingRegister(size_t offset, int value) {
+  if (modbusIsServer()) {
+    if (modbusIsRtu()) {
+      modbusRtuServer.holdingRegisterWrite(offset, value);
+    } else {
+      modbusTcpServer.holdingRegisterWrite(offset, value);
+    }
+  }
+}
+
+void Opta::modbusSetInputRegister(size_t offset, int value) {
+  if (modbusIsServer()) {
+    if (modbusIsRtu()) {
+      modbusRtuServer.inputRegisterWrite(offset, value);
+    } else {
+      modbusTcpServer.inputRegisterWrite(offset, value);
+    }
+  }
+}
+
+void Opta::modbusSetCoil(size_t coil, int value) {
+  if (modbusIsServer()) {
+    if (modbusIsRtu()) {
+      modbusRtuServer.coilWrite(coil, value > 0 ? 1 : 0);
+    } else {
+      modbusTcpServer.coilWrite(coil, value > 0 ? 1 : 0);
+    }
+
+    // also update output value in Input Registers
+    modbusSetRegister(modbusOutputValue(coil), value > 0 ? 1 : 0);
+  }
+}
+
+void Opta::modbusScanSetup() {
+  // entries sorted by server, function and start, so adjacent ranges follow each other
+  ModbusScan scans[ModbusScansMax];
+  size_t num = _configModbusScansNum;
+  for (size_t i = 0; i < num; i++) {
+    ModbusScan scan = _configModbusScans[i];
+    size_t j = i;
+    for (; j > 0; j--) {
+      const ModbusScan &prev = scans[j - 1];
+      if (prev.server < scan.server || (prev.server == scan.server && (prev.function < scan.function
+          || (prev.function == scan.function && prev.start <= scan.start)))) {
+        break;
+      }
+      scans[j] = prev;
+    }
+    scans[j] = scan;
+  }
+
+  // adjacent or overlapping ranges are coalesced into one request, polled at the fastest period
+  size_t cache = 0;
+  _modbusRequestsNum = 0;
+  for (size_t i = 0; i < num; i++) {
+    const ModbusScan &scan = scans[i];
+    const size_t max = scan.function <= 2 ? 2000 : 125;  // protocol limits for bits and registers
+    if (_modbusRequestsNum > 0) {
+      ModbusRequest &last = _modbusRequests[_modbusRequestsNum - 1];
+      size_t lastEnd = last.start + last.length;
+      size_t end = scan.start + scan.length > lastEnd ? scan.start + scan.length : lastEnd;
+      if (last.server == scan.server && last.function == scan.function && scan.start <= lastEnd
+          && end - last.start <= max && cache + end - lastEnd <= OPTA2IOT_MODBUS_CACHE) {
+        cache += end - lastEnd;
+        last.length = end - last.start;
+        if (scan.period < last.period) {
+          last.period = scan.period;
+        }
+
+        continue;
+      }
+    }
+
+    if (cache + scan.length > OPTA2IOT_MODBUS_CACHE) {
+      serialWarn(label_modbus_scan_full);
+
+      break;
+    }
+
+    ModbusRequest &request = _modbusRequests[_modbusRequestsNum++];
+    request.server = scan.server;
+    request.function = scan.function;
+    request.start = scan.start;
+    request.length = scan.length;
+    request.period = scan.period;
+    request.cache = cache;
+    request.valid = false;
+    cache += scan.length;
+  }
+
+  for (size_t i = 0; i < _modbusRequestsNum; i++) {
+    _modbusRequests[i].last = now() - _modbusRequests[i].period;  // first poll as soon as possible
+  }
+  _modbusRequestsNext = 0;
+  _modbusClientState = ModbusClientState::ModbusClientIdle;
+
+  serialInfo(label_modbus_scan + String(_modbusRequestsNum));
+}
+
+void Opta::modbusClientLoop() {
+  if (_modbusRequestsNum == 0) {
+    return;
+  }
+
+  if (_modbusClientState == ModbusClientState::ModbusClientWait) {
+    ModbusRequest &request = _modbusRequests[_modbusClientCurrent];
+    int ret = modbusClientReceive(request);
+    if (ret == 0) {
+      if (now() - _modbusClientTime < OPTA2IOT_MODBUS_RESPONSE_TIMEOUT) {
+        return;
+      }
+
+      serialWarn(label_modbus_scan_timeout + String(request.server));
+      if (!modbusIsRtu() && modbusClientConnection()) {
+        modbusClientConnection()->stop();  // drop late response
+      }
+    }
+    _modbusClientState = ModbusClientState::ModbusClientIdle;
+
+    return;
+  }
+
+  if (modbusIsRtu() ? !rs485IsSilent(rs485T35()) : !modbusClientConnection()) {
+    return;
+  }
+
+  // next due request, round robin so a fast entry does not starve others
+  for (size_t i = 0; i < _modbusRequestsNum; i++) {
+    size_t index = (_modbusRequestsNext + i) % _modbusRequestsNum;
+    ModbusRequest &request = _modbusRequests[index];
+    if (now() - request.last >= request.period) {
+      _modbusRequestsNext = index + 1;
+      _modbusClientCurrent = index;
+      request.last = now();
+      modbusClientSend(request);
+
+      return;
+    }
+  }
+}
+
+Client *Opta::modbusClientConnection() {
+  Client *client = networkIsEthernet() ? (Client *)&modbusEthernetClient : (Client *)&_modbusWifiClient;
+
+  // client belongs to connect thread until it is done
+  if (_modbusConnecting) {
+    if (!_modbusConnectDone) {
+      return nullptr;
+    }
+    _modbusConnecting = false;
+    if (!_modbusConnectResult || _modbusConnectClient != client) {
+      return nullptr;
+    }
+  }
+
+  if (client->connected()) {
+    return client;
+  }
+  if (!networkIsConnected() || now() - _modbusClientConnectTime < OPTA2IOT_MODBUS_RECONNECT) {
+    return nullptr;
+  }
+
+  if (!_modbusConnectThreaded) {
+    _modbusConnectThreaded = true;
+
+    static rtos::Thread thread(osPriorityNormal, 4096);
+    thread.start([]() {
+      // rtos::Thread.start() requires a static callback
+      if (instance) {
+        instance->modbusConnectThread();
+      }
+    });
+  }
+
+  // blocking TCP connect is done by the connect thread, result is read on a next loop
+  _modbusClientConnectTime = now();
+  serialInfo(label_modbus_tcp_connect + configGetModbusIp());
+  client->stop();
+  _modbusConnectClient = client;
+  _modbusConnectIp = networkParseIp(configGetModbusIp());
+  _modbusConnectPort = configGetModbusPort();
+  _modbusConnectDone = false;
+  _modbusConnecting = true;
+  _modbusConnectFlags.set(1);
+
+  return nullptr;
+}
+
+void Opta::modbusConnectThread() {
+  while (true) {
+    _modbusConnectFlags.wait_any(1);
+
+    _modbusConnectResult = _modbusConnectClient->connect(_modbusConnectIp, _modbusConnectPort);
+    _modbusConnectDone = true;
+  }
+}
+
+void Opta::modbusClientSend(ModbusRequest &request) {
+  uint8_t *frame = _modbusClientBuffer;
+  size_t length = 0;
+  if (modbusIsRtu()) {
+    frame[length++] = request.server;
+  } else {
+    _modbusClientTransaction++;
+    frame[length++] = _modbusClientTransaction >> 8;
+    frame[length++] = _modbusClientTransaction & 0xFF;
+    frame[length++] = 0;  // protocol
+    frame[length++] = 0;
+    frame[length++] = 0;  // length of unit and PDU
+    frame[length++] = 6;
+    frame[length++] = request.server;
+  }
+  frame[length++] = request.function;
+  frame[length++] = request.start >> 8;
+  frame[length++] = request.start & 0xFF;
+  frame[length++] = request.length >> 8;
+  frame[length++] = request.length & 0xFF;
+
+  if (modbusIsRtu()) {
+    uint16_t crc = modbusCrc(frame, length);
+    frame[length++] = crc & 0xFF;
+    frame[length++] = crc >> 8;
+
+    while (RS485.available()) {
+      RS485.read();  // drop stale bytes
+    }
+    rs485SetDelays(true);  // silence already checked by modbusClientLoop()
+    RS485.noReceive();
+    RS485.beginTransmission();
+    RS485.write(frame, length);
+    RS485.endTransmission();
+    RS485.receive();
+    rs485SetDelays(false);
+    rs485SetActivity();
+  } else {
+    modbusClientConnection()->write(frame, length);
+  }
+
+  _modbusClientLength = 0;
+  _modbusClientTime = now();
+  _modbusClientState = ModbusClientState::ModbusClientWait;
+}
+
+int Opta::modbusClientReceive(ModbusRequest &request) {
+  // response is accumulated until its length is known and reached
+  uint8_t *frame = _modbusClientBuffer;
+  const size_t header = modbusIsRtu() ? 1 : 7;  // server ID, or MBAP header with unit
+  if (modbusIsRtu()) {
+    if (RS485.available()) {
+      rs485SetActivity();
+    }
+    while (_modbusClientLength < ModbusAduMax && RS485.available()) {
+      frame[_modbusClientLength++] = RS485.read();
+    }
+  } else {
+    Client *client = modbusClientConnection();
+    if (!client) {
+      return -1;
+    }
+    int available = client->available();
+    size_t space = ModbusAduMax - _modbusClientLength;
+    if (available > 0 && space > 0) {
+      int read = client->read(frame + _modbusClientLength, (size_t)available < space ? available : space);
+      if (read > 0) {
+        _modbusClientLength += read;
+      }
+    }
+  }
+
+  // t3.5 silence ends a RTU frame, even a short one
+  const bool ended = modbusIsRtu() && _modbusClientLength > 0 && rs485IsSilent(rs485T35());
+  if (_modbusClientLength < header + 2) {
+    return ended ? -1 : 0;
+  }
+
+  const uint8_t *pdu = frame + header;
+  size_t expected = modbusIsRtu()
+    ? header + ((pdu[0] & 0x80) ? 2 : 2 + pdu[1]) + 2  // with CRC
+    : 6 + ((frame[4] << 8) | frame[5]);
+  if (expected > ModbusAduMax) {
+    return -1;
+  }
+  if (_modbusClientLength < expected) {
+    return ended ? -1 : 0;
+  }
+
+  if (modbusIsRtu()) {
+    uint16_t crc = modbusCrc(frame, expected - 2);
+    if (frame[0] != request.server || frame[expected - 2] != (crc & 0xFF) || frame[expected - 1] != (crc >> 8)) {
+      return -1;
+    }
+  } else if (((frame[0] << 8) | frame[1]) != _modbusClientTransaction || frame[6] != request.server) {
+    return -1;
+  }
+
+  if (pdu[0] != request.function) {
+    serialWarn(label_modbus_scan_error + String(request.server) + " (" + String(pdu[1]) + ")");
+
+    return -1;
+  }
+  if (pdu[1] != (request.function <= 2 ? (request.length + 7) / 8 : request.length * 2)) {
+    return -1;
+  }
+
+  modbusClientStore(request, pdu + 2);
+
+  return 1;
+}
+
+void Opta::modbusClientStore(ModbusRequest &request, const uint8_t *data) {
+  static const char *types[] = { "", "co", "di", "hr", "ir" };
+  char topic[MqttTopicSize + 24];
+  int length = snprintf(topic, sizeof(topic), "%smodbus/%u/%s/", mqttTopic(MqttTopicRoot), request.server, types[request.function]);
+
+  // only changed values are published, all after a broker outage
+  for (size_t i = 0; i < request.length; i++) {
+    uint16_t value = request.function <= 2 ? (data[i / 8] >> (i % 8)) & 1 : (data[i * 2] << 8) | data[i * 2 + 1];
+    uint16_t &cached = _modbusCache[request.cache + i];
+    if (!request.valid || cached != value) {
+      cached = value;
+      snprintf(topic + length, sizeof(topic) - length, "%u", (unsigned int)(request.start + i));
+      mqttPublish(topic, String(value));
+    }
+  }
+  request.valid = mqttIsConnected() || !mqttIsEnabled();
+}
+
+uint16_t Opta::modbusCrc(const uint8_t *data, size_t length) {
+  // CRC16 Modbus, bitwise, frames are short
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (byte j = 0; j < 8; j++) {
+      crc = (crc >> 1) ^ (0xA001 & -(crc & 1));
+    }
+  }
+
+  return crc;
+}
+
+bool Opta::modbusGetCached(uint8_t server, uint8_t function, uint16_t address, uint16_t &value) {
+  for (size_t i = 0; i < _modbusRequestsNum; i++) {
+    const ModbusRequest &request = _modbusRequests[i];
+    if (request.server == server && request.function == function
+        && address >= request.start && address < request.start + request.length) {
+      value = _modbusCache[request.cache + address - request.start];
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool Opta::modbusGetCoil(uint8_t server, size_t coil) {
+  if (modbusIsEnabled() && !modbusIsServer()) {
+    if (modbusIsRtu()) {
+      return modbusRtuClient.coilRead(coil) == 1;
+    } else {
+      return modbusTcpClient.coilRead(coil) == 1;
+    }
+  }
+
+  return false;
+}
+
+bool Opta::modbusGetDiscreteInputs(int *response, uint8_t server, size_t length) {
+  if (!modbusIsEnabled() || modbusIsServer()) {
+    return false;
+  }
+
+  if (modbusIsRtu()) {
+    if (!modbusRtuClient.requestFrom(server, DISCRETE_INPUTS, 0x00, length)) {
+        serialWarn(String("Modbus: ") + modbusRtuClient.lastError());
+        return false;
+    }
+
+    size_t index = 0;
+    while (modbusRtuClient.available()) {
+        response[index++] = modbusRtuClient.read();
+    }
+  }
+
+  return true;
+}
+
+bool Opta::modbusGetRegisters(int *response, uint8_t type, uint8_t server, size_t start, size_t length) {
+  if (!modbusIsEnabled() || modbusIsServer()) {
+    return false;
+  }
+
+  if (modbusIsRtu()) {
+    if (!modbusRtuClient.requestFrom(server, type, start, length)) {
+        serialWarn(String("Modbus: ") + modbusRtuClient.lastError());
+        return false;
+    }
+
+    size_t index = 0;
+    while (modbusRtuClient.available()) {
+      response[index++] = modbusRtuClient.read();
+    }
   }
 
   return true;
@@ -2330,6 +4382,18 @@ bool Opta::modbusGetInputRegisters(int *response, uint8_t server, size_t start,
   return modbusGetRegisters(response, INPUT_REGISTERS, server, start, length);
 }
 
+long Opta::modbusGetHoldingRegister(size_t offset) {
+  if (modbusIsServer()) {
+    if (modbusIsRtu()) {
+        return modbusRtuServer.holdingRegisterRead(offset);
+    } else {
+        return modbusTcpServer.holdingRegisterRead(offset);
+    }
+  }
+
+  return -1;
+}
+
 long Opta::modbusGetInputRegister(size_t offset) {
   if (modbusIsServer()) {
     if (modbusIsRtu()) {
@@ -2362,6 +4426,15 @@ bool Opta::mqttSetup() {
     }
     ledSetFreeze(false);
 
+    static rtos::Thread thread(osPriorityNormal, 4096);
+    thread.start([]() {
+      // rtos::Thread.start() requires a static callback
+      if (instance) {
+        instance->mqttConnectThread();
+      }
+    });
+
+    // connection is done later from loop
     mqttConnect();
 
     watchdogPing();
@@ -2373,17 +4446,16 @@ bool Opta::mqttSetup() {
 bool Opta::mqttLoop() {
   if (mqttIsEnabled()) {
     mqttConnect();
-    if (mqttIsConnected()) {
-      int rspSize = mqttClient.parseMessage();
-      if (rspSize) {
-        String rspTopic = mqttClient.messageTopic();
-        String rspPayload = "";
-
-        for (int index = 0; index < rspSize; index++) {
-          rspPayload += (char)mqttClient.read();
-        }
-
-        mqttReceive(rspTopic, rspPayload);
+    // a message being read is finished before holding MQTT reading
+    if (mqttIsConnected() && (_mqttRxSize > 0 || !rs485BridgeHold())) {
+      if (_mqttRxSize == 0) {
+        int rspSize = mqttClient.parseMessage();
+        _mqttRxSize = rspSize > 0 ? rspSize : 0;
+        _mqttRxLength = 0;
+        _mqttRxStart = now();
+      }
+      if (_mqttRxSize > 0) {
+        mqttRead();
       }
     }
   }
@@ -2391,8 +4463,49 @@ bool Opta::mqttLoop() {
   return running();
 }
 
+void Opta::mqttRead() {
+  // payload is read in place as it arrives, a too large message is read out and dropped
+  const size_t size = _mqttRxSize;
+  while (_mqttRxLength < size) {
+    size_t chunk = size - _mqttRxLength;
+    uint8_t *target = _mqttRxBuffer + _mqttRxLength;
+    if (size > OPTA2IOT_MQTT_RX_SIZE) {
+      target = _mqttRxBuffer;
+      chunk = chunk < OPTA2IOT_MQTT_RX_SIZE ? chunk : OPTA2IOT_MQTT_RX_SIZE;
+    }
+    int ret = mqttClient.read(target, chunk);
+    if (ret <= 0) {
+      break;
+    }
+    _mqttRxLength += ret;
+  }
+
+  // payload split over network packets is read on next loops, for a bounded time
+  if (_mqttRxLength < size && now() - _mqttRxStart < OPTA2IOT_MQTT_RX_TIMEOUT) {
+    return;
+  }
+  _mqttRxSize = 0;
+
+  String topic = mqttClient.messageTopic();
+  if (size > OPTA2IOT_MQTT_RX_SIZE) {
+    serialWarn(label_mqtt_receive_drop + topic + " (" + String(size) + ")");
+
+    return;
+  }
+  if (_mqttRxLength != size) {
+    serialWarn(label_mqtt_receive_partial + topic + " (" + String(_mqttRxLength) + "/" + String(size) + ")");
+
+    return;
+  }
+
+  _mqttRxBuffer[size] = '\0';
+  MqttMessage message = { topic.c_str(), _mqttRxBuffer, size };
+  mqttReceive(message);
+}
+
 bool Opta::mqttSetConnected(bool connected) {
   _mqttConnected = connected;
+  _mqttRxSize = 0;  // a message being read belongs to previous connection
 
   return true;
 }
@@ -2405,123 +4518,352 @@ bool Opta::mqttIsConnected() {
   return _mqttConnected;
 }
 
-void Opta::mqttConnect() {
-  if (!networkIsConnected() || networkIsAccessPoint()) {
+void Opta::mqttRestart() {
+  // a connection in progress is restarted once done
+  if (_mqttState == MqttState::MqttStateConnecting && !_mqttConnectDone) {
+    _mqttRestart = true;
+
     return;
   }
-  if (mqttClient.connected()) {
-    mqttSetConnected(true);
-    _mqttLastRetry = 0;
-    return;
+
+  serialInfo(label_mqtt_restart);
+  _mqttRestart = false;
+  mqttClient.stop();
+  mqttSetConnected(false);
+  _mqttState = MqttState::MqttStateIdle;
+  _mqttLastRetry = 0;
+}
+
+void Opta::mqttConnect() {
+  switch (_mqttState) {
+
+    case MqttState::MqttStateIdle:
+      if (!networkIsConnected() || networkIsAccessPoint() || !networkPoll(_mqttLastRetry)) {  // retry every x seconds
+        return;
+      }
+
+      _mqttLastRetry = now();
+      serialLine(label_mqtt_broker);
+
+      // blocking TCP connect and CONNACK wait are done by the connect thread
+      mqttClient.setId(configGetDeviceId());
+      mqttClient.setUsernamePassword(configGetMqttUser(), configGetMqttPassword());
+      mqttClient.setConnectionTimeout(networkTimeout());
+      _mqttConnectHost = configGetMqttIp();
+      _mqttConnectDone = false;
+      _mqttState = MqttState::MqttStateConnecting;
+      _mqttConnectFlags.set(1);
+    break;
+
+    case MqttState::MqttStateConnecting:
+      if (!_mqttConnectDone) {
+        return;
+      }
+
+      if (!_mqttConnectResult) {
+        serialWarn(label_mqtt_broker_fail);
+        _mqttState = MqttState::MqttStateIdle;
+        // retry uses the new configuration, no restart needed, just do not wait for it
+        if (_mqttRestart) {
+          _mqttRestart = false;
+          _mqttLastRetry = 0;
+        }
+        return;
+      }
+
+      // configuration changed while connecting
+      if (_mqttRestart) {
+        mqttRestart();
+        return;
+      }
+
+      serialInfo(label_mqtt_broker_success);
+      _mqttSubscribeIndex = 0;
+      _mqttState = MqttState::MqttStateSubscribing;
+    break;
+
+    case MqttState::MqttStateSubscribing:
+      // one topic per loop
+      if (mqttSubscribeNext()) {
+        return;
+      }
+
+      _mqttState = MqttState::MqttStateConnected;
+      _mqttLastRetry = 0;
+      mqttSetConnected(true);
+
+      // publish again inputs type to new session
+      for (size_t i = 0; i < BoardInputsMax; i++) {
+        _ioPublishedType[i] = 0xFF;
+      }
+
+      mqttPublishDevice();
+
+      // inputs changed while offline, send current state, journal is replayed later
+      if (_journalOffline) {
+        _journalOffline = false;
+        mqttPublishInputs();
+      }
+    break;
+
+    case MqttState::MqttStateConnected:
+      if (!mqttClient.connected()) {
+        serialWarn(label_mqtt_broker_lost);
+        mqttSetConnected(false);
+        _mqttState = MqttState::MqttStateIdle;
+      }
+    break;
   }
+}
+
+void Opta::mqttConnectThread() {
+  while (true) {
+    _mqttConnectFlags.wait_any(1);
+
+    _mqttConnectResult = mqttClient.connect(_mqttConnectHost.c_str(), configGetMqttPort());
+    _mqttConnectDone = true;
+  }
+}
+
+bool Opta::mqttSubscribeNext() {
+  const char *topic;
+  size_t index = _mqttSubscribeIndex++;
+
+  if (index == 0) {
+    topic = mqttTopic(MqttTopicDeviceGet);  // command for device information
+  } else if (index == 1) {
+    topic = mqttTopic(MqttTopicPerfGet);  // command for loop profiler
+  } else if (index - 2 < boardGetOutputsNum()) {
+    topic = mqttTopic(MqttTopicOutput + index - 2);  // command for outputs
+  } else if (index - 2 == boardGetOutputsNum()) {
+    if (!rs485IsBridge()) {
+      return true;  // nothing to subscribe, go on with handlers on next loop
+    }
+    topic = mqttTopic(MqttTopicRs485Tx);  // message to send on RS485 bus
+  } else if (index - 3 - boardGetOutputsNum() < _mqttHandlersNum) {
+    topic = _mqttHandlers[index - 3 - boardGetOutputsNum()].pattern;  // sketch handlers
+  } else {
+    return false;
+  }
+
+  mqttClient.subscribe(topic);
+  serialInfo(label_mqtt_subscribe + String(topic));
+
+  return true;
+}
+
+bool Opta::mqttSubscribe(String topic) {
+  if(mqttIsConnected()) {
+    mqttClient.subscribe(topic);
+
+    return true;
+  }
+
+  return false;
+}
+
+bool Opta::mqttPublish(String topic, String message) {
+  return mqttPublish(topic.c_str(), message);
+}
+
+bool Opta::mqttPublish(const char *topic, const String &message) {
+  if(mqttIsConnected()) {
+    mqttClient.beginMessage(topic);
+    mqttClient.print(message);
+    mqttClient.endMessage();
+
+    return true;
+  }
+
+  return false;
+}
+
+void Opta::mqttSetTopics() {
+  static const char *suffixes[] = { "", "device/get", "device/perf/get", "device/type", "device/ip", "device/revision", "device/perf", "inputs", "journal", "rs485/tx", "rs485/rx" };
+  static const char *fields[] = { "val", "type", "count" };
+
+  char *root = _mqttTopics[MqttTopicRoot];
+  snprintf(root, MqttTopicSize, "%s%s/", _configMqttBase.c_str(), _configDeviceId.c_str());
+  _mqttRootLength = strlen(root);
+
+  for (size_t i = MqttTopicRoot + 1; i < MqttTopicInput; i++) {
+    snprintf(_mqttTopics[i], MqttTopicSize, "%s%s", root, suffixes[i]);
+  }
+  for (size_t i = 0; i < boardGetInputsNum(); i++) {
+    for (size_t field = 0; field < MqttInputTopicsNum; field++) {
+      snprintf(_mqttTopics[MqttTopicInput + i * MqttInputTopicsNum + field], MqttTopicSize, "%sI%u/%s", root, (unsigned int)(i + 1), fields[field]);
+    }
+  }
+  for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+    snprintf(_mqttTopics[MqttTopicOutput + i], MqttTopicSize, "%sO%u", root, (unsigned int)(i + 1));
+  }
+}
+
+const char *Opta::mqttTopic(size_t topic) const {
+  return topic < MqttTopicsNum ? _mqttTopics[topic] : _mqttTopics[MqttTopicRoot];
+}
 
-  if (!networkPoll(_mqttLastRetry)) {  // retry every x seconds
-    return;
-  }
+const char *Opta::mqttInputTopic(size_t index, size_t field) const {
+  return mqttTopic(MqttTopicInput + index * MqttInputTopicsNum + field);
+}
 
-  mqttSetConnected(false);
-  _mqttLastRetry = millis();
-  serialLine(label_mqtt_broker);
+void Opta::mqttReceive(const MqttMessage &message) {
+  const char *payload = (const char *)message.payload;
+  serialLine(label_mqtt_receive + String(message.topic) + " = " + payload);
 
-  ledSetFreeze(true);
-  mqttClient.setId(configGetDeviceId());
-  mqttClient.setUsernamePassword(configGetMqttUser(), configGetMqttPassword());
-  mqttClient.setConnectionTimeout(networkTimeout()); // This directive has no effect !
-  if (!mqttClient.connect(configGetMqttIp().c_str(), configGetMqttPort())) {
-    serialWarn(label_mqtt_broker_fail);
-    ledSetFreeze(false);
-    return;
+  // sketch handlers get every matching message, including device topics
+  for (size_t i = 0; i < _mqttHandlersNum; i++) {
+    if (mqttMatch(_mqttHandlers[i].pattern, message.topic)) {
+      _mqttHandlers[i].callback(message, _mqttHandlers[i].context);
+    }
   }
-  ledSetFreeze(false);
 
-  serialInfo(label_mqtt_broker_success);
-  mqttSetConnected(true);
+  // every subscribed topic starts with device root, only the remaining part is compared
+  if (strncmp(message.topic, mqttTopic(MqttTopicRoot), _mqttRootLength) != 0) {
+    return;
+  }
+  const char *suffix = message.topic + _mqttRootLength;
 
-  String topic = configGetMqttBase() + configGetDeviceId() + "/device/get";  // command for device information
-  mqttClient.subscribe(topic);
-  serialInfo(label_mqtt_subscribe + topic);
+  if (suffix[0] == 'O') {
+    char *end;
+    unsigned long output = strtoul(suffix + 1, &end, 10);
+    if (end != suffix + 1 && *end == '\0' && output >= 1 && output <= boardGetOutputsNum()) {
+      serialInfo("Setting output " + String(output) + " to " + payload);
 
-  for (size_t i = 0; i < boardGetOutputsNum(); i++) {
-    String topic = configGetMqttBase() + configGetDeviceId() + "/O" + String(i + 1);  // command for outputs
-    mqttClient.subscribe(topic);
-    serialInfo(label_mqtt_subscribe + topic);
+      ioSetDigitalOuput(output - 1, strtol(payload, nullptr, 10) != 0);
+    }
+  } else if (strcmp(suffix, mqttTopic(MqttTopicDeviceGet) + _mqttRootLength) == 0) {
+    mqttPublishDevice();
+  } else if (strcmp(suffix, mqttTopic(MqttTopicPerfGet) + _mqttRootLength) == 0) {
+    mqttPublishPerf();
+  } else if (strcmp(suffix, mqttTopic(MqttTopicRs485Tx) + _mqttRootLength) == 0) {
+    if (rs485IsBridge() && !rs485Send(message.payload, message.length)) {
+      serialWarn(label_rs485_bridge_drop);
+    }
   }
-
-  mqttPublishDevice();
 }
 
-bool Opta::mqttSubscribe(String topic) {
-  if(mqttIsConnected()) {
-    mqttClient.subscribe(topic);
+bool Opta::mqttOn(const char *pattern, MqttCallback callback, void *context) {
+  if (callback == nullptr || pattern == nullptr || pattern[0] == '\0' || strlen(pattern) >= OPTA2IOT_MQTT_PATTERN_SIZE) {
+    return false;
+  }
 
-    return true;
+  // wildcards must fill a whole level, multi level wildcard must be the last one
+  for (const char *c = pattern; *c; c++) {
+    bool level = (c == pattern || c[-1] == '/') && (c[1] == '\0' || c[1] == '/');
+    if ((*c == '+' && !level) || (*c == '#' && (!level || c[1] != '\0'))) {
+      return false;
+    }
   }
 
-  return false;
-}
+  if (_mqttHandlersNum >= OPTA2IOT_MQTT_HANDLERS) {
+    return false;
+  }
 
-bool Opta::mqttPublish(String topic, String message) {
-  if(mqttIsConnected()) {
-    mqttClient.beginMessage(topic);
-    mqttClient.print(message);
-    mqttClient.endMessage();
+  MqttHandler &handler = _mqttHandlers[_mqttHandlersNum];
+  strcpy(handler.pattern, pattern);
+  handler.callback = callback;
+  handler.context = context;
+  _mqttHandlersNum++;
 
-    return true;
+  // already connected, otherwise subscribed with device topics on connection
+  if (mqttIsConnected()) {
+    mqttClient.subscribe(handler.pattern);
+    serialInfo(label_mqtt_subscribe + String(handler.pattern));
   }
 
-  return false;
+  return true;
 }
 
-void Opta::mqttReceive(String &topic, String &payload) {
-  serialLine(label_mqtt_receive + topic + " = " + payload);
-
-  String match = configGetMqttBase() + configGetDeviceId() + "/device/get";
-  if (topic == match) {
-    mqttPublishDevice();
+bool Opta::mqttMatch(const char *pattern, const char *topic) {
+  // topics starting with $ are not matched by a leading wildcard
+  if (topic[0] == '$' && (pattern[0] == '+' || pattern[0] == '#')) {
+    return false;
   }
 
-  for (size_t i = 0; i < boardGetInputsNum(); i++) {
-    String match = configGetMqttBase() + configGetDeviceId() + "/O" + String(i + 1);
-    if (topic == match) {
-      serialInfo("Setting output " + String(i + 1) + " to " + payload);
-
-      ioSetDigitalOuput(i, (bool)payload.toInt());
+  while (*pattern) {
+    if (*pattern == '#') {
+      return true;
     }
+    if (*pattern == '+') {
+      while (*topic && *topic != '/') {
+        topic++;
+      }
+      pattern++;
+      continue;
+    }
+    if (*pattern != *topic) {
+      // "a/#" also matches parent level "a"
+      return *topic == '\0' && strcmp(pattern, "/#") == 0;
+    }
+    pattern++;
+    topic++;
   }
+
+  return *topic == '\0';
 }
 
 void Opta::mqttPublishDevice() {
   if (networkIsConnected() && mqttIsConnected()) {
     serialLine(label_mqtt_publish_device);
 
-    String rootTopic = configGetMqttBase() + configGetDeviceId();
-
-    mqttPublish(String(rootTopic + "/device/type").c_str(), boardGetName().c_str());
-    mqttPublish(String(rootTopic + "/device/ip").c_str(), networkLocalIp().toString());
-    mqttPublish(String(rootTopic + "/device/revision").c_str(), String(Revision).c_str());
+    mqttPublish(mqttTopic(MqttTopicDeviceType), boardGetName());
+    mqttPublish(mqttTopic(MqttTopicDeviceIp), networkLocalIp().toString());
+    mqttPublish(mqttTopic(MqttTopicDeviceRevision), String(Revision));
 
     /*
     for (size_t i = 0; i < boardGetOutputsNum(); i++) {
       // for now all output are digital
-      mqttClient.publish(String(rootTopic + "/O" + (i + 1)).c_str(), String(digitalRead(BoardOutputs[i])).c_str());
+      mqttClient.publish(mqttTopic(MqttTopicOutput + i), String(digitalRead(BoardOutputs[i])).c_str());
     }
     //*/
   }
 }
 
+void Opta::mqttPublishBatch(JsonDocument &batch) {
+  if (batch.size() == 0) {
+    return;
+  }
+
+  if (mqttIsConnected()) {
+    // serialize straight into the MQTT message, no intermediate String
+    const char *topic = mqttTopic(MqttTopicInputs);
+    if (configGetMqttBatch() == MqttBatch::MqttBatchPack) {
+      mqttClient.beginMessage(topic, measureMsgPack(batch));
+      serializeMsgPack(batch, mqttClient);
+    } else {
+      mqttClient.beginMessage(topic, measureJson(batch));
+      serializeJson(batch, mqttClient);
+    }
+    mqttClient.endMessage();
+  }
+
+  batch.clear();
+}
+
+bool Opta::mqttIsBatch() {
+  return configGetMqttBatch() != MqttBatch::MqttBatchNone;
+}
+
+void Opta::mqttPublishPerf() {
+  if (networkIsConnected() && mqttIsConnected()) {
+    serialLine(label_mqtt_publish_perf);
+
+    mqttPublish(mqttTopic(MqttTopicPerf), perfToJson());
+  }
+}
+
 void Opta::mqttPublishInputs() {
   if (networkIsConnected() && mqttIsConnected()) {
     serialLine(label_mqtt_publish_inputs);
 
-    String rootTopic = configGetMqttBase() + configGetDeviceId() + "/";
     for (size_t i = 0; i < boardGetInputsNum(); i++) {
-      String inTopic = "I" + String(i + 1) + "/";
       if (configGetInputType(i) == IoType::IoAnalog) {
-        mqttPublish(String(rootTopic + inTopic + "val").c_str(), ioGetAnalogInputString(i).c_str());
-        mqttPublish(String(rootTopic + inTopic + "type").c_str(), String(configGetInputType(i)).c_str());
+        mqttPublish(mqttInputTopic(i, MqttInputVal), ioGetAnalogInputString(i));
+        mqttPublish(mqttInputTopic(i, MqttInputType), String(configGetInputType(i)));
       } else {
-        mqttPublish(String(rootTopic + inTopic + "val").c_str(), String(ioGetDigitalInput(i)).c_str());
-        mqttPublish(String(rootTopic + inTopic + "type").c_str(), String(configGetInputType(i)).c_str());
+        mqttPublish(mqttInputTopic(i, MqttInputVal), String(ioGetDigitalInput(i)));
+        mqttPublish(mqttInputTopic(i, MqttInputType), String(configGetInputType(i)));
       }
     }
   }
@@ -2544,6 +4886,7 @@ bool Opta::webSetup() {
     serialInfo(label_web_wifi);
     webWifiServer.begin();
   }
+  webSetAuth();
   ledSetFreeze(false);
 
   watchdogPing();
@@ -2552,199 +4895,302 @@ bool Opta::webSetup() {
 }
 
 bool Opta::webLoop() {
-  if (networkIsConnected() && odd()) {  // _odd: leave place for other things
-    Client *webClient = nullptr;
-    if (networkIsEthernet()) {
-      EthernetClient webEthernetClient = webEthernetServer.accept();
-      webClient = &webEthernetClient;
-      if (webClient) {
-        webConnect(webClient);
-      }
-    } else {
-      WiFiClient webWifiClient = webWifiServer.accept();
-      webClient = &webWifiClient;
-      if (webClient) {
-        webConnect(webClient);
+  if (networkIsConnected()) {
+    webAccept();
+
+    // each client does one step, so one slow client never holds the loop
+    for (size_t i = 0; i < OPTA2IOT_WEB_CLIENTS; i++) {
+      if (_webConnections[i].state != WebStateIdle) {
+        webProcess(_webConnections[i]);
       }
     }
+
+    webEvents();
   }
 
   return running();
 }
 
-void Opta::webConnect(Client *&client) {
-  client->setTimeout(5000);
-  String webConnectRequest = "";
-  int webConnectLength = 0;
-  bool webConnectAuth = false;
-  bool webConnectBlank = true;
-  char webConnectBuffer[100];
-  //memset(webConnectBuffer, 0, sizeof(webConnectBuffer));
+void Opta::webSetAuth() {
+  // Basic authentication string is computed once, not on every header line
+  char input[sizeof(ConfigRecord::deviceUser) + sizeof(ConfigRecord::devicePassword)];  // user:password and null
+  snprintf(input, sizeof(input), "%s:%s", configGetDeviceUser().c_str(), configGetDevicePassword().c_str());
+  encode_base64((unsigned char *)input, strlen(input), (unsigned char *)_webAuth);
+}
+
+void Opta::webAccept() {
+  for (size_t i = 0; i < OPTA2IOT_WEB_CLIENTS; i++) {
+    WebConnection &conn = _webConnections[i];
+    if (conn.state != WebStateIdle) {
+      continue;
+    }
 
-  while (client->connected()) {
-    // NOTE: Try to kill Wifi waiting client
-    if (!client->available()) {
-      for (size_t i = 0; i < 250; i++) {
-        delay(1);
-        if (client->available()) {
-          break;
-        }
+    if (networkIsEthernet()) {
+      _webEthernetClients[i] = webEthernetServer.accept();
+      if (!_webEthernetClients[i]) {
+        return;
       }
-      if (!client->available()) {
-        client->stop();
-        break;
+      conn.client = &_webEthernetClients[i];
+    } else {
+      _webWifiClients[i] = webWifiServer.accept();
+      if (!_webWifiClients[i]) {
+        return;
       }
+      conn.client = &_webWifiClients[i];
     }
 
-    if (client->available()) {  // NOTE: Wifi server client "available" sometimes freeze too long for the loop.
-      // Read client request
-      char webChar = client->read();
-      webConnectBuffer[webConnectLength] = webChar;
-      if (webConnectLength < (int)sizeof(webConnectBuffer) - 1) {
-        webConnectLength++;
-      }
+    conn.state = WebStateRequest;
+    conn.route = WebRouteError;
+    conn.request.begin(_webAuth, OPTA2IOT_WEB_BODY_TIMEOUT);
+    conn.time = now();
+    conn.data = nullptr;
+    conn.dataLength = 0;
+    conn.socket.begin();
+  }
+}
 
-      if (webChar == '\n' && webConnectBlank) {
-        if (webConnectAuth) {
-          if (!webConnectRequest) {
-            // grab end of request
-            webConnectRequest = client->readStringUntil('\r');
-            //webConnectRequest = client->readString();
-          }
+void Opta::webProcess(WebConnection &conn) {
+  // live data clients are kept alive by webEvents()
+  if (!conn.client->connected() || now() - conn.time > OPTA2IOT_WEB_TIMEOUT) {
+    webClose(conn);
 
-          client->flush();  // nothing more to read
-
-          if (webConnectRequest.startsWith("GET /style.css")) {
-            webSendStyle(client);
-          } else if (webConnectRequest.startsWith("POST /form")) {
-            webReceiveConfig(client);
-          } else if (webConnectRequest.startsWith("GET /publish ")) {
-            webReceivePublish(client);
-          } else if (webConnectRequest.startsWith("GET /config ")) {
-            webSendConfig(client);
-          } else if (webConnectRequest.startsWith("GET /data ")) {
-            webSendData(client);
-          } else if (webConnectRequest.startsWith("GET /device ")) {
-            webSendDevice(client);
-          } else if (webConnectRequest.startsWith("GET / ")) {
-            webSendHome(client);
-          } else if (webConnectRequest.startsWith("GET /favicon.ico")) {
-            webSendFavicon(client);
-          } else {
-            webSendError(client);
-          }
-        } else {
-          webSendAuth(client);
-        }
-        client->stop();
-        break;
+    return;
+  }
+
+  switch (conn.state) {
+    case WebStateRequest:
+      webRead(conn);
+      break;
+    case WebStateSend:
+      webWrite(conn);
+      break;
+    case WebStateEvents:
+      while (conn.client->available() > 0) {  // nothing expected from client
+        conn.client->read();
       }
+      break;
+    case WebStateSocket:
+      webSocketRead(conn);
+      break;
+  }
+}
+
+void Opta::webRead(WebConnection &conn) {
+  // request is parsed over several loops, the body is collected in the shared body buffer
+  int index = &conn - _webConnections;
+  size_t consumed = conn.request.consumed();
+  byte result = conn.request.read(*conn.client, _webBody, index, now(), OPTA2IOT_WEB_CHUNK);
+  if (conn.request.consumed() != consumed) {
+    conn.time = now();
+  }
 
-      if (webChar == '\n') {
-        webConnectBlank = true;
+  switch (result) {
+    case HttpRequest<OPTA2IOT_WEB_LINE>::HttpReady:
+      webParseRequest(conn);
+      webRespond(conn);
+      _webBody.release(index);
+      break;
+    case HttpRequest<OPTA2IOT_WEB_LINE>::HttpTooLarge:
+      webSendStatus(conn.client, "413 Payload Too Large", false, "Configuration too large");
+      webClose(conn);
+      break;
+    case HttpRequest<OPTA2IOT_WEB_LINE>::HttpBusy:
+      webSendStatus(conn.client, "503 Service Unavailable", false, "Configuration already in progress");
+      webClose(conn);
+      break;
+    case HttpRequest<OPTA2IOT_WEB_LINE>::HttpTimeout:
+      webSendStatus(conn.client, "408 Request Timeout", false, "Configuration not received");
+      webClose(conn);
+      break;
+  }
+}
 
-        // prepare basic auth ! I s*** at this
-        String inputString = configGetDeviceUser() + ":" + configGetDevicePassword();
-        char inputChar[32];
-        inputString.toCharArray(inputChar, sizeof(inputChar));
-        unsigned char *unsInputChar = (unsigned char *)inputChar;
-        int inputLength = strlen((char *)unsInputChar);
-        //int encodedLength = encode_base64_length(inputLength) + 1;
-        //unsigned char encodedString[encodedLength];
-        unsigned char encodedString[32];
-        encode_base64(unsInputChar, inputLength, encodedString);
+void Opta::webParseRequest(WebConnection &conn) {
+  // unsupported methods and too long paths have an empty path
+  const char *path = conn.request.path;
+  auto is = [&](const char *route) {
+    return strcmp(path, route) == 0;
+  };
+
+  if (conn.request.post) {
+    conn.route = is("/form") ? WebRouteForm : WebRouteError;
+  } else if (is("/")) {
+    conn.route = WebRouteHome;
+  } else if (is("/device")) {
+    conn.route = WebRouteDevice;
+  } else if (is("/style.css")) {
+    conn.route = WebRouteStyle;
+  } else if (is("/favicon.ico")) {
+    conn.route = WebRouteFavicon;
+  } else if (is("/config")) {
+    conn.route = WebRouteConfig;
+  } else if (is("/data")) {
+    conn.route = WebRouteData;
+  } else if (is("/events")) {
+    conn.route = WebRouteEvents;
+  } else if (is("/ws")) {
+    conn.route = WebRouteSocket;
+  } else if (is("/perf")) {
+    conn.route = WebRoutePerf;
+  } else if (is("/publish")) {
+    conn.route = WebRoutePublish;
+  } else {
+    conn.route = WebRouteError;
+  }
+}
 
-        // check basic auth
-        if (strstr(webConnectBuffer, "Authorization: Basic ") && strstr(webConnectBuffer, (char *)encodedString)) {
-          webConnectAuth = true;
-        }
+void Opta::webRespond(WebConnection &conn) {
+  // static responses are streamed by webWrite(), others are sent at once
+  conn.state = WebStateSend;
 
-        // if web line buffer is the request
-        if (strstr(webConnectBuffer, "GET /") || strstr(webConnectBuffer, "POST /")) {
-          webConnectRequest = webConnectBuffer;
-        }
+  if (!conn.request.auth) {
+    webSendAuth(conn);
 
-        //memset(webConnectBuffer, 0, sizeof(webConnectBuffer));
-        webConnectLength = 0;
-      } else if (webChar != '\r') {
-        webConnectBlank = false;
-      }
+    return;
+  }
+
+  switch (conn.route) {
+    case WebRouteHome:
+      webSendHome(conn);
+      break;
+    case WebRouteDevice:
+      webSendDevice(conn);
+      break;
+    case WebRouteStyle:
+      webSendStyle(conn);
+      break;
+    case WebRouteFavicon:
+      webSendFavicon(conn);
+      break;
+    case WebRouteConfig:
+      webSendConfig(conn.client);
+      break;
+    case WebRouteData:
+      webSendData(conn.client);
+      break;
+    case WebRouteEvents:
+      webSendEvents(conn);
+      break;
+    case WebRouteSocket:
+      webSendSocket(conn);
+      break;
+    case WebRoutePerf:
+      webSendPerf(conn.client);
+      break;
+    case WebRoutePublish:
+      webReceivePublish(conn.client);
+      break;
+    case WebRouteForm:
+      webReceiveConfig(conn.client, _webBody.data, conn.request.received);
+      break;
+    default:
+      webSendError(conn);
+  }
+}
+
+void Opta::webWrite(WebConnection &conn) {
+  if (conn.dataLength > 0) {
+    size_t size = conn.dataLength < OPTA2IOT_WEB_CHUNK ? conn.dataLength : OPTA2IOT_WEB_CHUNK;
+    size_t written = conn.client->write(conn.data, size);
+    if (written > 0) {
+      conn.data += written;
+      conn.dataLength -= written;
+      conn.time = now();
     }
   }
-  client->stop();
+
+  if (conn.dataLength == 0) {
+    webClose(conn);
+  }
+}
+
+void Opta::webClose(WebConnection &conn) {
+  _webBody.release(&conn - _webConnections);
+  conn.client->stop();
+  conn.client = nullptr;
+  conn.state = WebStateIdle;
+}
+
+void Opta::webSendHeaders(Client *&client, const char *status, const char *type, size_t length, const char *extra) {
+  char headers[256];
+  snprintf(headers, sizeof(headers), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n%sConnection: close\r\n\r\n", status, type, (unsigned int)length, extra);
+  client->write((const uint8_t *)headers, strlen(headers));
 }
 
-void Opta::webSendFavicon(Client *&client) {
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: image/x-icon");
-  client->println("Connnection: close");
-  client->println();
+void Opta::webSendStream(WebConnection &conn, const char *status, const char *type, const void *data, size_t length, const char *extra) {
+  webSendHeaders(conn.client, status, type, length, extra);
+  conn.data = (const uint8_t *)data;
+  conn.dataLength = length;
+}
+
+void Opta::webSendAsset(WebConnection &conn, const char *type, const void *raw, size_t rawLength, const uint8_t *gz, size_t gzLength, const char *etag, uint32_t maxAge) {
+  // compressed and raw contents have their own ETag
+  bool gzip = conn.request.gzip && gz != nullptr;
+  char tag[16];
+  snprintf(tag, sizeof(tag), "\"%s%s\"", etag, gzip ? "-gz" : "");
+
+  char extra[160];
+  snprintf(extra, sizeof(extra), "ETag: %s\r\nCache-Control: private, %s%u\r\n%s%s",
+           tag,
+           maxAge ? "max-age=" : "no-cache, max-age=",
+           (unsigned int)maxAge,
+           gz ? "Vary: Accept-Encoding\r\n" : "",
+           gzip ? "Content-Encoding: gzip\r\n" : "");
+
+  if (strcmp(conn.request.match, tag) == 0) {
+    webSendHeaders(conn.client, "304 Not Modified", type, gzip ? gzLength : rawLength, extra);
 
-  const byte bufferSize = 48;
-  uint8_t buffer[bufferSize];
-  const size_t n = sizeof web_favicon_hex / bufferSize;
-  const size_t r = sizeof web_favicon_hex % bufferSize;
-  for (size_t i = 0; i < sizeof web_favicon_hex; i += bufferSize) {
-    memcpy_P(buffer, web_favicon_hex + i, bufferSize);
-    client->write(buffer, bufferSize);
+    return;
   }
-  if (r != 0) {
-    memcpy_P(buffer, web_favicon_hex + n * bufferSize, r);
-    client->write(buffer, r);
+
+  if (gzip) {
+    webSendStream(conn, "200 OK", type, gz, gzLength, extra);
+  } else {
+    webSendStream(conn, "200 OK", type, raw, rawLength, extra);
   }
 }
 
-void Opta::webSendStyle(Client *&client) {
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: text/css");
-  client->println("Connection: close");
-  client->println();
-  client->println(web_style_css);
+void Opta::webSendStatus(Client *&client, const char *status, bool success, const char *message, const char *extra) {
+  char body[96];
+  snprintf(body, sizeof(body), "{\"status\":\"%s\",\"message\":\"%s\"}", success ? "success" : "error", message);
+  webSendHeaders(client, status, "application/json", strlen(body), extra);
+  client->write((const uint8_t *)body, strlen(body));
 }
 
-void Opta::webSendAuth(Client *&client) {
-  client->println("HTTP/1.1 401 Authorization Required");
-  client->println("WWW-Authenticate: Basic realm=\"Secure Area\"");
-  client->println("Content-Type: text/html");
-  client->println("Connnection: close");
-  client->println();
-  client->println(web_auth_html);
+void Opta::webSendFavicon(WebConnection &conn) {
+  webSendAsset(conn, "image/x-icon", web_favicon_hex, sizeof(web_favicon_hex), nullptr, 0, web_favicon_hex_etag, OPTA2IOT_WEB_CACHE);
 }
 
-void Opta::webSendError(Client *&client) {
-  client->println("HTTP/1.1 404 Not Found");
-  client->println("Content-Type: text/html");
-  client->println("Connnection: close");
-  client->println();
-  client->println(web_error_html);
+void Opta::webSendStyle(WebConnection &conn) {
+  webSendAsset(conn, "text/css", web_style_css, sizeof(web_style_css) - 1, web_style_css_gz, sizeof(web_style_css_gz), web_style_css_etag, OPTA2IOT_WEB_CACHE);
 }
 
-void Opta::webSendHome(Client *&client) {
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: text/html");
-  client->println("Connection: close");
-  client->println();
-  client->println(web_home_html);
+void Opta::webSendAuth(WebConnection &conn) {
+  webSendStream(conn, "401 Authorization Required", "text/html", web_auth_html, sizeof(web_auth_html) - 1, "WWW-Authenticate: Basic realm=\"Secure Area\"\r\n");
 }
 
-void Opta::webSendDevice(Client *&client) {
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: text/html");
-  client->println("Connection: close");
-  client->println();
-  client->println(web_device_html);
+void Opta::webSendError(WebConnection &conn) {
+  webSendStream(conn, "404 Not Found", "text/html", web_error_html, sizeof(web_error_html) - 1);
 }
 
-void Opta::webSendConfig(Client *&client) {
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: application/json");
-  client->println("Connection: close");
-  client->println();
-  client->println(configWriteToJson(true));
+void Opta::webSendHome(WebConnection &conn) {
+  webSendAsset(conn, "text/html", web_home_html, sizeof(web_home_html) - 1, web_home_html_gz, sizeof(web_home_html_gz), web_home_html_etag, 0);
 }
 
-void Opta::webSendData(Client *&client) {
+void Opta::webSendDevice(WebConnection &conn) {
+  webSendAsset(conn, "text/html", web_device_html, sizeof(web_device_html) - 1, web_device_html_gz, sizeof(web_device_html_gz), web_device_html_etag, 0);
+}
+
+void Opta::webSendConfig(Client *&client) {
   JsonDocument doc;
+  configToJson(doc, true);
+
+  webSendHeaders(client, "200 OK", "application/json", measureJson(doc));
+  serializeJson(doc, *client);
+}
+
+void Opta::webDataToJson(JsonDocument &doc, uint64_t inputs, uint64_t outputs) {
+  // only inputs and outputs set in masks are added
   doc["deviceId"] = configGetDeviceId();
   doc["version"] = version();
   doc["mqttConnected"] = mqttIsConnected();
@@ -2753,6 +5199,9 @@ void Opta::webSendData(Client *&client) {
 
   JsonObject inputsObject = doc["inputs"].to<JsonObject>();
   for (size_t i = 0; i < boardGetInputsNum(); i++) {
+    if (!(inputs & (1ULL << i))) {
+      continue;
+    }
     String name = "I" + String(i + 1);
     JsonObject obj = inputsObject[name].to<JsonObject>();
     obj["type"] = configGetInputType(i);
@@ -2765,43 +5214,241 @@ void Opta::webSendData(Client *&client) {
 
   JsonObject outputsObj = doc["outputs"].to<JsonObject>();
   for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+    if (!(outputs & (1ULL << i))) {
+      continue;
+    }
     String name = "O" + String(i + 1);
     outputsObj[name] = digitalRead(BoardOutputs[i]);
   }
-  String jsonString;
-  serializeJson(doc, jsonString);
+}
 
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: application/json");
-  client->println("Connection: close");
-  client->println();
-  client->println(jsonString);
+void Opta::webSendData(Client *&client) {
+  JsonDocument doc;
+  webDataToJson(doc, ~0ULL, ~0ULL);
+
+  webSendHeaders(client, "200 OK", "application/json", measureJson(doc));
+  serializeJson(doc, *client);
 }
 
-void Opta::webReceiveConfig(Client *&client) {
-  serialLine(label_web_config);
+void Opta::webSendEvents(WebConnection &conn) {
+  // stream stays open, first event is the full state, next ones only have changes
+  const char headers[] = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n";
+  conn.client->write((const uint8_t *)headers, sizeof(headers) - 1);
 
-  bool isValid = true;
-  String jsonString = "";
+  JsonDocument doc;
+  webDataToJson(doc, ~0ULL, ~0ULL);
 
-  String oldDevicePassword = configGetDevicePassword();
-  String oldNetPassword = configGetNetworkPassword();
-  String oldMqttPassword = configGetMqttPassword();
+  conn.client->write((const uint8_t *)"data: ", 6);
+  serializeJson(doc, *conn.client);
+  conn.client->write((const uint8_t *)"\n\n", 2);
 
-  ledSetFreeze(true);
-  while (client->available()) {
-    String line = client->readStringUntil('\n');  // Read line-by-line
+  conn.state = WebStateEvents;
+  conn.time = now();
+}
 
-    if (line == "\r") {  // Detect the end of headers (an empty line)
-      isValid = false;
+void Opta::webEvents() {
+  uint64_t inputs = _ioChangedInputs;
+  uint64_t outputs = _ioChangedOutputs;
+  _ioChangedInputs = _ioChangedOutputs = 0;
+
+  bool mqtt = mqttIsConnected();
+  if (!inputs && !outputs && mqtt == _webEventsMqtt && now() - _webEventsLast < OPTA2IOT_WEB_EVENTS_PING) {
+    return;
+  }
+  _webEventsMqtt = mqtt;
+  _webEventsLast = now();
+
+  bool listening = false;
+  for (size_t i = 0; i < OPTA2IOT_WEB_CLIENTS; i++) {
+    listening |= _webConnections[i].state == WebStateEvents || _webConnections[i].state == WebStateSocket;
+  }
+  if (!listening) {
+    return;
+  }
+
+  // serialized once for all clients, Server-Sent Events or WebSocket
+  size_t length = webSerializeEvent(inputs, outputs);
+  if (length == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < OPTA2IOT_WEB_CLIENTS; i++) {
+    WebConnection &conn = _webConnections[i];
+    if (conn.state == WebStateEvents) {
+      conn.client->write((const uint8_t *)"data: ", 6);
+      conn.client->write((const uint8_t *)_webEvent, length);
+      if (conn.client->write((const uint8_t *)"\n\n", 2) > 0) {
+        conn.time = now();
+      }
+    } else if (conn.state == WebStateSocket) {
+      webSocketWrite(conn.client, 0x1, _webEvent, length);
+      conn.time = now();
+    }
+  }
+}
+
+size_t Opta::webSerializeEvent(uint64_t inputs, uint64_t outputs) {
+  JsonDocument doc;
+  webDataToJson(doc, inputs, outputs);
+
+  // a truncated event is not valid JSON, it is not sent
+  if (measureJson(doc) >= sizeof(_webEvent)) {
+    return 0;
+  }
+
+  return serializeJson(doc, _webEvent, sizeof(_webEvent));
+}
+
+void Opta::webSendSocket(WebConnection &conn) {
+  if (!conn.request.upgrade || conn.request.key[0] == '\0') {
+    webSendStatus(conn.client, "400 Bad Request", false, "Missing WebSocket upgrade or key");
+
+    return;
+  }
+  if (conn.request.version != 13) {
+    webSendStatus(conn.client, "426 Upgrade Required", false, "Unsupported WebSocket version", "Sec-WebSocket-Version: 13\r\n");
+
+    return;
+  }
+  // browsers send Basic credentials from any page, so only device own pages can open a socket
+  if (!webSocketOrigin(conn)) {
+    webSendStatus(conn.client, "403 Forbidden", false, "WebSocket origin not allowed");
+
+    return;
+  }
+
+  // RFC 6455 handshake
+  char input[64];
+  snprintf(input, sizeof(input), "%s258EAFA5-E914-47DA-95CA-C5AB0DC85B11", conn.request.key);
+  unsigned char hash[20];
+  mbedtls_sha1_ret((const unsigned char *)input, strlen(input), hash);
+  char accept[32];
+  encode_base64(hash, sizeof(hash), (unsigned char *)accept);
+
+  char headers[160];
+  snprintf(headers, sizeof(headers), "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", accept);
+  conn.client->write((const uint8_t *)headers, strlen(headers));
+
+  // first message is the full state, next ones only have changes
+  size_t length = webSerializeEvent(~0ULL, ~0ULL);
+  if (length > 0) {
+    webSocketWrite(conn.client, 0x1, _webEvent, length);
+  }
+
+  conn.state = WebStateSocket;
+  conn.socket.begin();
+  conn.time = now();
+}
+
+bool Opta::webSocketOrigin(WebConnection &conn) {
+  // origin is scheme://host[:port], it must be the requested host or the device IP
+  const char *origin = conn.request.origin;
+  if (strncasecmp(origin, "http://", 7) == 0) {
+    origin += 7;
+  } else if (strncasecmp(origin, "https://", 8) == 0) {
+    origin += 8;
+  } else {
+    return false;
+  }
+
+  return (conn.request.host[0] != '\0' && strcasecmp(origin, conn.request.host) == 0)
+         || strcmp(origin, networkLocalIp().toString().c_str()) == 0;
+}
+
+void Opta::webSocketRead(WebConnection &conn) {
+  size_t budget = OPTA2IOT_WEB_CHUNK;
+  size_t consumed = conn.socket.consumed();
+
+  while (conn.state == WebStateSocket) {
+    byte result = conn.socket.read(*conn.client, budget);
+    if (result == WebSocketReader<OPTA2IOT_WEB_FRAME>::SocketFrame) {
+      webSocketFrame(conn);
+    } else if (result == WebSocketReader<OPTA2IOT_WEB_FRAME>::SocketTooBig) {
+      webSocketClose(conn, 1009);
+    } else if (result == WebSocketReader<OPTA2IOT_WEB_FRAME>::SocketProtocolError) {
+      webSocketClose(conn, 1002);
+    } else {
       break;
     }
+  }
 
-    jsonString += line;
+  if (conn.state == WebStateSocket && conn.socket.consumed() != consumed) {
+    conn.time = now();
   }
-  watchdogPing();
+}
+
+void Opta::webSocketFrame(WebConnection &conn) {
+  const uint8_t *payload = conn.socket.payload();
+  size_t size = conn.socket.size();
+
+  if (!conn.socket.fin()) {
+    webSocketClose(conn, 1003);  // fragmented messages are not supported
+
+    return;
+  }
+
+  switch (conn.socket.opcode()) {
+    case 0x1: {  // text, outputs command like {"O1":1,"O2":0}
+      JsonDocument doc;
+      if (deserializeJson(doc, (const char *)payload, size)) {
+        break;
+      }
+      for (size_t i = 0; i < boardGetOutputsNum(); i++) {
+        JsonVariant value = doc["O" + String(i + 1)];
+        if (!value.isNull()) {
+          serialInfo("Setting output " + String(i + 1) + " to " + String(value.as<int>()));
+
+          ioSetDigitalOuput(i, value.as<bool>());
+        }
+      }
+      break;
+    }
+    case 0x8:  // close
+      webSocketClose(conn, 1000);
+      break;
+    case 0x9:  // ping
+      webSocketWrite(conn.client, 0xA, payload, size);
+      break;
+    case 0xA:  // pong
+      break;
+    default:
+      webSocketClose(conn, 1003);
+  }
+}
+
+void Opta::webSocketWrite(Client *&client, uint8_t opcode, const void *data, size_t length) {
+  uint8_t header[4];
+  size_t size = WebSocketReader<OPTA2IOT_WEB_FRAME>::header(header, opcode, length);
+  client->write(header, size);
+  client->write((const uint8_t *)data, length);
+}
+
+void Opta::webSocketClose(WebConnection &conn, uint16_t code) {
+  uint8_t status[2] = { (uint8_t)(code >> 8), (uint8_t)(code & 0xFF) };
+  webSocketWrite(conn.client, 0x8, status, sizeof(status));
+  webClose(conn);
+}
 
-  if (!isValid || configReadFromJson(jsonString.c_str(), jsonString.length()) < 1) {
+void Opta::webSendPerf(Client *&client) {
+  String json = perfToJson();
+  webSendHeaders(client, "200 OK", "application/json", json.length());
+  client->write((const uint8_t *)json.c_str(), json.length());
+}
+
+void Opta::webReceiveConfig(Client *&client, const char *body, size_t length) {
+  serialLine(label_web_config);
+
+  bool isValid = true;
+
+  String oldDevicePassword = configGetDevicePassword();
+  String oldNetPassword = configGetNetworkPassword();
+  String oldMqttPassword = configGetMqttPassword();
+
+  JsonDocument previous;
+  configToJson(previous, false);
+
+  ledSetFreeze(true);
+  if (length == 0 || configReadFromJson(body, length) < 1) {
     serialWarn(label_web_config_fail);
     isValid = false;
   } else {
@@ -2835,20 +5482,21 @@ void Opta::webReceiveConfig(Client *&client) {
   if (isValid) {
     configWriteToFile();
 
-    client->println("HTTP/1.1 200 OK");
-    client->println("Content-Type: application/json");
-    client->println("Connection: close");
-    client->println();
-    client->println("{\"status\":\"success\",\"message\":\"Configuration updated\"}");
-    client->stop();
+    // only changes of network or Modbus mode require a reboot
+    byte scope = configDiff(previous);
+    if (scope & ConfigScopeReboot) {
+      webSendStatus(client, "200 OK", true, "Configuration updated. Device is going to reboot");
+      client->stop();
 
-    reboot();
+      reboot();
+    } else {
+      serialInfo(label_config_hot);
+      configApply(scope, previous);
+      webSendStatus(client, "200 OK", true, "Configuration updated and applied");
+    }
   } else {
-    client->println("HTTP/1.1 403 FORBIDDEN");
-    client->println("Content-Type: application/json");
-    client->println("Connection: close");
-    client->println();
-    client->println("{\"status\":\"error\",\"message\":\"Configuration not updated\"}");
+    configFromJson(previous);
+    webSendStatus(client, "403 FORBIDDEN", false, "Configuration not updated");
   }
   ledSetFreeze(false);
 }
@@ -2857,11 +5505,7 @@ void Opta::webReceivePublish(Client *&client) {
   mqttPublishDevice();
   mqttPublishInputs();
 
-  client->println("HTTP/1.1 200 OK");
-  client->println("Content-Type: application/json");
-  client->println("Connection: close");
-  client->println();
-  client->println("{\"status\":\"success\",\"message\":\"Informations published\"}");
+  webSendStatus(client, "200 OK", true, "Informations published");
 }
 
 }  // namespace
\ No newline at end of file
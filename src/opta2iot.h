@@ -21,8 +21,17 @@
 #include <Ethernet.h>
 #include <ArduinoMqttClient.h>
 #include <ArduinoModbus.h>
+#include <ArduinoJson.h>
 #include "BlockDevice.h"
 #include "define.h"
+#include "scheduler.h"
+#include "histogram.h"
+#include "ring.h"
+#include "reconnect.h"
+#include "http.h"
+#include "websocket.h"
+#include "modbustcp.h"
+#include "rs485.h"
 
 #ifndef CORE_CM7
 #error "opta2iot must run on M7 Main Core"
@@ -61,9 +70,31 @@ public:
   bool endSetup();
   bool startLoop();
 
+  // Scheduled loop tasks, ordered by priority
+  enum LoopTask {
+    LoopIo = 0,
+    LoopModbus,
+    LoopRs485,
+    LoopButton,
+    LoopMqtt,
+    LoopJournal,
+    LoopNetwork,
+    LoopSerial,
+    LoopTime,
+    LoopWeb,
+    LoopLed
+  };
+
   /* tools */
   int getHex(int value);
 
+  // Profiler
+
+  bool perfSetup();
+  void perfReset();
+  void perfPrint();
+  String perfToJson();
+
   // Watchdog
 
   bool watchdogSetup();
@@ -143,7 +174,7 @@ public:
 
   bool configSetup();
 
-  String configGetDeviceId() const;
+  const String &configGetDeviceId() const;
   void configSetDeviceId(const String &id);
   String configGetDeviceUser() const;
   void configSetDeviceUser(const String &user);
@@ -178,8 +209,10 @@ public:
   void configSetMqttUser(const String &user);
   String configGetMqttPassword() const;
   void configSetMqttPassword(const String &password);
-  String configGetMqttBase() const;
+  const String &configGetMqttBase() const;
   void configSetMqttBase(const String &base);
+  byte configGetMqttBatch() const;
+  void configSetMqttBatch(byte batch);
   int configGetMqttInterval() const;
   void configSetMqttInterval(int interval);
 
@@ -191,16 +224,38 @@ public:
   void configSetModbusIp(const String &ip);
   int configGetModbusPort() const;
   void configSetModbusPort(const int port);
+  uint32_t configGetRs485Baudrate() const;
+  void configSetRs485Baudrate(uint32_t baudrate);
+  byte configGetRs485Parity() const;
+  void configSetRs485Parity(byte parity);
+  bool configGetRs485Bridge() const;
+  void configSetRs485Bridge(bool bridge);
+  uint16_t configGetRs485Window() const;
+  void configSetRs485Window(uint16_t window);
+  size_t configGetModbusScansNum() const;
+  bool configAddModbusScan(uint8_t server, uint8_t function, uint16_t start, uint16_t length, uint32_t period);
+  void configClearModbusScans();
 
   byte configGetInputType(size_t index);
   bool configSetInputType(size_t index, byte type);
+  uint16_t configGetInputDeadband(size_t index);
+  bool configSetInputDeadband(size_t index, uint16_t deadband);
 
   bool configReadFromJson(const char *buffer, size_t length);
+  bool configReadFromJson(Stream &input);
   String configWriteToJson(const bool nopass = true);
+  size_t configWriteToJson(Print &output, const bool nopass = true);
   bool configReadFromFile();
   bool configWriteToFile();
   void configReadFromDefault();
 
+  // Journal
+
+  bool journalSetup();
+  bool journalLoop();
+  bool journalIsEnabled();
+  size_t journalPending();
+
   // IO
 
   enum IoType {
@@ -218,6 +273,9 @@ public:
   String ioGetAnalogInputString(size_t index);    // get analog input value as readable string
   void ioSetDigitalOuput(size_t index, bool on);  // set digital output state
   bool ioGetDigitalOutput(size_t index);          // get memorized digital output state
+  bool ioIsCaptured(size_t index);                // check if input edges are captured from interrupt
+  uint32_t ioGetPulseCount(size_t index);         // get number of rising edges of a captured pulse input
+  uint32_t ioGetCaptureLost();                    // get number of edges lost on capture buffer overflow
 
   // Network
 
@@ -249,11 +307,38 @@ public:
 
   // RS485
 
+  // Bytes are timed in receive thread every OPTA2IOT_RS485_POLL, bytes waiting together are timed back
+  // from character time: if the thread is held longer than a silence, frames around it are not split right
+  enum Rs485Framing {
+    Rs485FramingGap = 0,    // frame ends on bus silence, parameter is silence in microseconds (0 = t3.5)
+    Rs485FramingDelimiter,  // frame ends with delimiter byte given as parameter, delimiter is not part of frame
+    Rs485FramingLength      // first byte is frame length, parameter is maximum silence inside frame in microseconds (0 = none)
+  };
+
+  struct Rs485Frame {
+    const uint8_t *data;
+    size_t length;
+  };
+
+  typedef void (*Rs485Callback)(bool sent, void *context);  // called from loop once a message is sent
+
   bool rs485Setup();
+  bool rs485Loop();
   bool rs485IsEnabled();
-  bool rs485Incoming();
-  String rs485Received();
-  bool rs485Send(String msg);
+  bool rs485IsBridge();
+  void rs485SetFraming(byte framing, uint32_t parameter = 0);
+  bool rs485Incoming();                 // a received frame is waiting
+  bool rs485Peek(Rs485Frame &frame);    // view of oldest received frame, valid until rs485Release()
+  void rs485Release();                  // drop oldest received frame
+  String rs485Received();               // copy of oldest received frame, then drop it
+  uint32_t rs485GetOverruns();          // number of received frames lost
+  bool rs485Send(String msg);                                   // queue a message, false if queue is full
+  bool rs485Send(const uint8_t *data, size_t length, Rs485Callback callback = nullptr, void *context = nullptr);
+  size_t rs485Pending();                                        // number of messages waiting to be sent
+  uint32_t rs485CharTime();  // in microseconds
+  uint32_t rs485T15();       // in microseconds, maximum silence inside a Modbus RTU frame
+  uint32_t rs485T35();       // in microseconds, minimum silence between Modbus RTU frames
+  bool rs485IsSilent(uint32_t gap);
 
   // Modbus
 
@@ -273,23 +358,44 @@ public:
   void modbusSetHoldingRegister(size_t offset, int value);
   void modbusSetInputRegister(size_t offset, int value);
   long modbusGetInputRegister(size_t offset);
+  long modbusGetHoldingRegister(size_t offset);
   void modbusSetCoil(size_t coil, int value);
   bool modbusGetCoil(uint8_t server, size_t coil);
 
   bool modbusGetDiscreteInputs(int *response, uint8_t server, size_t length = 4);
   bool modbusGetHoldingRegisters(int *response, uint8_t server, size_t start = 0, size_t length = 100);
   bool modbusGetInputRegisters(int *response, uint8_t server, size_t start = 0, size_t length = 100);
+  bool modbusGetCached(uint8_t server, uint8_t function, uint16_t address, uint16_t &value);  // last value read by scan list
 
   // MQTT
 
+  enum MqttBatch {
+    MqttBatchNone = 0,  // one topic per input value
+    MqttBatchJson,      // one JSON message per poll
+    MqttBatchPack       // one MessagePack message per poll
+  };
+
+  struct MqttMessage {
+    const char *topic;
+    const uint8_t *payload;  // view on receive buffer, valid only during callback, followed by a null byte
+    size_t length;
+  };
+
+  typedef void (*MqttCallback)(const MqttMessage &message, void *context);  // called from loop for each matching message
+
   bool mqttSetup();
   bool mqttLoop();
   bool mqttIsEnabled();
   bool mqttIsConnected();
+  bool mqttIsBatch();
   bool mqttSubscribe(String topic);
   bool mqttPublish(String topic, String message);
+  bool mqttPublish(const char *topic, const String &message);
   void mqttPublishDevice();
   void mqttPublishInputs();
+  void mqttPublishPerf();
+  bool mqttOn(const char *pattern, MqttCallback callback, void *context = nullptr);  // false if pattern is invalid or registry is full
+  static bool mqttMatch(const char *pattern, const char *topic);
 
   // Web
 
@@ -307,6 +413,17 @@ private:
   char _version[17]; // Human readable version
   bool _started = false;
   bool _threaded = false;
+  Scheduler _loopScheduler;
+  void loopSchedule();
+  bool loopRun(byte task);
+  const char *loopName(byte task);
+
+  // Profiler
+
+  static const byte PerfTasksMax = 11;  // one histogram per LoopTask
+  bool _perfStarted = false;
+  Histogram _perfTasks[PerfTasksMax];
+  uint32_t perfCycles();
 
   // Watchdog
 
@@ -319,6 +436,7 @@ private:
 
   // Board
 
+  static const byte ModbusScansMax = 16;                                       // Maximum number of modbus client scan list entries
   static const byte BoardInputsMax = 44;                                       // Maximum number of inputs for board + expansions
   static const byte BoardOutputsMax = 44;                                      // Maximum number of outputs for board + expansions
   const unsigned int BoardInputs[8] = { A0, A1, A2, A3, A4, A5, A6, A7 };      // I1, I2, I3, I4, I5, I6, I7, I8
@@ -353,6 +471,83 @@ private:
 
   // Config
 
+  enum ConfigScope {
+    ConfigScopeNone = 0,
+    ConfigScopeWeb = 1,
+    ConfigScopeMqtt = 2,
+    ConfigScopeIo = 4,
+    ConfigScopeModbus = 8,
+    ConfigScopeRegisters = 16,
+    ConfigScopeTime = 32,
+    ConfigScopeReboot = 128
+  };
+
+  // Binary configuration record, new fields must be appended at the end,
+  // so a record from an older version is read field by field and missing fields keep their default value.
+  static const uint16_t ConfigRecordMagic = 0x4F32;
+  static const uint16_t ConfigRecordVersion = 4;
+
+  struct ModbusScan {
+    uint8_t server;
+    uint8_t function;  // 1 = coils, 2 = discrete inputs, 3 = holding registers, 4 = input registers
+    uint16_t start;
+    uint16_t length;
+    uint32_t period;   // in milliseconds
+  };
+
+  struct ConfigRecord {
+    char deviceId[33];
+    char deviceUser[33];
+    char devicePassword[65];
+    int8_t timeOffset;
+    uint8_t networkDhcp;
+    uint8_t networkWifi;
+    char networkIp[16];
+    char networkGateway[16];
+    char networkSubnet[16];
+    char networkDns[16];
+    char networkSsid[33];
+    char networkPassword[65];
+    char mqttIp[16];
+    uint16_t mqttPort;
+    char mqttUser[65];
+    char mqttPassword[65];
+    char mqttBase[129];
+    uint16_t mqttInterval;
+    uint8_t mqttBatch;
+    uint8_t modbusType;
+    uint8_t modbusId;
+    char modbusIp[16];
+    uint16_t modbusPort;
+    uint8_t inputs[44];
+    uint16_t inputsDeadband[44];
+    uint8_t modbusScansNum;  // since version 2
+    ModbusScan modbusScans[16];
+    uint32_t rs485Baudrate;  // since version 3
+    uint8_t rs485Parity;
+    uint8_t rs485Bridge;  // since version 4
+    uint16_t rs485Window;
+  };
+
+  struct ConfigHeader {
+    uint16_t magic;
+    uint16_t version;
+    uint16_t size;  // size of stored record, up to end of its last field
+    uint16_t reserved;
+    uint32_t crc;   // CRC32 of stored record
+  };
+
+  void configToRecord(ConfigRecord &record);
+  void configFromRecord(const ConfigRecord &record);
+  bool configReadFromRecord();
+  static size_t configRecordEnd(uint16_t version);
+  bool configReadFromLegacy();
+  static uint32_t configCrc(const void *data, size_t length);
+  void configToJson(JsonDocument &doc, const bool nopass);
+  bool configFromJson(JsonDocument &doc);
+  byte configDiff(JsonDocument &previous);
+  void configApply(byte scope, JsonDocument &previous);
+
   String _configDeviceId;
   String _configDeviceUser;
   String _configDevicePassword;
@@ -374,31 +569,104 @@ private:
   String _configMqttPassword;
   String _configMqttBase;
   uint16_t _configMqttInterval;
+  byte _configMqttBatch;
 
   byte _configModbusType;
   uint8_t _configModbusId;
   String _configModbusIp;
   uint16_t _configModbusPort;
+  uint32_t _configRs485Baudrate = OPTA2IOT_RS485_BAUDRATE;
+  byte _configRs485Parity = OPTA2IOT_RS485_PARITY;
+  bool _configRs485Bridge = OPTA2IOT_RS485_BRIDGE;
+  uint16_t _configRs485Window = OPTA2IOT_RS485_WINDOW;
+  ModbusScan _configModbusScans[ModbusScansMax];
+  size_t _configModbusScansNum = 0;
 
   byte _configInputs[44];
+  uint16_t _configInputsDeadband[44];
+
+  // Journal
+
+  struct JournalRecord {
+    uint32_t seq;    // 0 = empty
+    uint32_t time;   // epoch
+    uint32_t value;  // mV for analog, level for digital, count for pulse
+    byte index;
+    byte type;
+    uint16_t check;
+  };
+  mbed::BlockDevice *_journalDevice = nullptr;  // raw flash region, one record per slot
+  size_t _journalSector = 0;  // number of records per erase sector
+  uint32_t _journalHead = 0;  // last written sequence
+  uint32_t _journalAck = 0;   // last replayed sequence
+  uint32_t _journalLost = 0;  // records overwritten or unreadable during replay
+  JournalRecord _journalBuffer[OPTA2IOT_JOURNAL_BUFFER];
+  size_t _journalBuffered = 0;
+  uint32_t _journalBufferStart = 0;
+  bool _journalOffline = false;
+  void journalWrite(size_t index, uint32_t value);
+  bool journalFlush();
+  bool journalRead(uint32_t seq, JournalRecord &record);
+  void journalReplay();
+  uint16_t journalCheck(const JournalRecord &record);
 
   // IO
 
   uint32_t _ioLastPoll = 0;
-  String _ioPreviousState[44];
+  uint16_t _ioPreviousSample[44];
+  uint64_t _ioChangedInputs = 0;   // inputs changed since last web event, one bit per input
+  uint64_t _ioChangedOutputs = 0;  // outputs changed since last web event, one bit per output
   byte _ioDigitalOutputs[44];
 
+  struct IoEdge {
+    uint32_t time;  // microseconds
+    byte index;
+    byte level;
+  };
+  Ring<IoEdge, OPTA2IOT_IO_CAPTURE_SIZE> _ioEdges;
+  bool _ioCaptured[44];
+  byte _ioCaptureState[44];
+  volatile uint32_t _ioPulseCount[44];
+  uint32_t _ioPulsePublished[44];
+  volatile uint32_t _ioCaptureLost = 0;
+  uint16_t ioSample(size_t index);
+  bool ioSampleChanged(size_t index, uint16_t sample);
+  uint32_t ioSampleMax();
+  uint16_t ioSampleToMillivolts(uint16_t sample);
+  void ioSampleToString(size_t index, uint16_t sample, char *buffer, size_t length);
+  void ioSetupInput(size_t index);
+  void ioCapture(byte index);
+  void ioCaptureDrain(JsonDocument &batch);
+  void ioPublishInput(size_t index, uint16_t sample, JsonDocument &batch);
+  byte _ioPublishedType[44];
+
+  template <byte index>
+  static void ioInterrupt() {
+    // attachInterrupt() requires a static callback per pin
+    if (instance) {
+      instance->ioCapture(index);
+    }
+  }
+
   // Network
 
   byte _networkType = NetworkType::NetworkNone;
   bool _networkConnected = false;
-  uint32_t _networkLastRetry = 0;
   bool _networkAccessPointFirstLoop = true;
   int _networkAccessPointStatus = WL_IDLE_STATUS;
   bool networkSetType(NetworkType type);
   bool networkSetConnected(bool connected);
   void networkConnectEthernet();
   void networkConnectStandard();
+  bool networkBeginEthernet();
+  bool networkBeginStandard();
+  void networkConnectEthernetResult(bool ret);
+  void networkConnectStandardResult(bool ret);
+  bool _networkThreaded = false;
+  Reconnect _networkReconnect{ OPTA2IOT_NETWORK_POLL * 1000 };
+  rtos::EventFlags _networkConnectFlags;
+  void networkConnectAsync();
+  void networkConnectThread();
 
   // Time
 
@@ -408,14 +676,40 @@ private:
   uint32_t _timeBenchmarkCount = 0;
   byte _timeBenchmarkRepeat = 0;
   uint32_t _timeBenchmarkSum = 0;
+  void timeBenchmark();
 
   // RS485
 
   bool _rs485Enabled = false;
-  bool _rs485Sending = false;
-  bool _rs485Incoming = false;
-  String _rs485Received = "";
-  void rs485Prepare();
+  // frames are received by a thread, then read from loop
+  Rs485Receiver<OPTA2IOT_RS485_RX_SIZE, OPTA2IOT_RS485_FRAMES> _rs485Rx;
+  rtos::Mutex _rs485RxLock;  // framing is changed from loop
+  void rs485ReceiveThread();
+
+  // messages are queued by sketch or library, then sent by a thread
+  struct Rs485Message {
+    uint16_t length;
+    Rs485Callback callback;
+    void *context;
+  };
+  Ring<uint8_t, OPTA2IOT_RS485_TX_SIZE> _rs485TxBytes;
+  Ring<Rs485Message, OPTA2IOT_RS485_TX_QUEUE> _rs485TxQueue;
+  Ring<Rs485Message, OPTA2IOT_RS485_TX_QUEUE> _rs485TxDone;  // sent messages waiting for their callback
+  rtos::Mutex _rs485TxLock;  // several producers
+  rtos::EventFlags _rs485TxFlags;
+  bool _rs485Threaded = false;
+  void rs485SendThread();
+
+  // MQTT bridge, received frames are published by batch, MQTT reading waits for room in send queue
+  uint32_t _rs485BridgeTime = 0;  // first frame of current batch
+  uint32_t _rs485BridgeHold = 0;  // start of MQTT reading hold
+  void rs485BridgeLoop();
+  bool rs485BridgeHold();
+  volatile uint32_t _rs485Activity = 0;  // in microseconds, last byte sent or received
+  void rs485Prepare(bool silence);
+  void rs485SetDelays(bool silence);
+  uint16_t rs485Config();
+  void rs485SetActivity();
 
   // Modbus
 
@@ -425,35 +719,257 @@ private:
   EthernetClient modbusEthernetClient;
   ModbusTCPClient modbusTcpClient;
   ModbusRTUClientClass modbusRtuClient;
+  // Registers layout, see docs/modbusserver.md
+  static constexpr size_t ModbusLengthStart = 0;
+  static constexpr size_t ModbusCommandsStart = 10;
+  static constexpr size_t ModbusCommandsLength = 20;
+  static constexpr size_t ModbusInputsStart = 30;
+  static constexpr size_t ModbusPartsNum = 6;  // commands, inputs, outputs, device, network, MQTT
+  enum ModbusPart {
+    ModbusPartCommands = 0,
+    ModbusPartInputs,
+    ModbusPartOutputs,
+    ModbusPartDevice,
+    ModbusPartNetwork,
+    ModbusPartMqtt
+  };
+  static constexpr size_t modbusInputValue(size_t index) {
+    return ModbusInputsStart + 2 + 2 * index + 1;
+  }
+  size_t modbusOutputValue(size_t index) {
+    return ModbusInputsStart + 2 + 2 * boardGetInputsNum() + 2 + 2 * index + 1;
+  }
+  uint16_t _modbusRegisters[OPTA2IOT_MODBUS_REGISTERS];  // image of server registers, persistent
+  size_t _modbusRegistersNum = 0;
+  uint32_t _modbusWriteTime = 0;  // start of an uncompleted Holding Registers update
   void modbusSetRegisters();
+  size_t modbusBuildRegisters();
+  void modbusSetRegister(size_t offset, uint16_t value);
+  void modbusMirror(size_t start, size_t end, bool inputs = true);
+  void modbusReceive();
+  bool modbusReceivePart(byte part, size_t start, size_t end);
+  void modbusSetDiscreteInput(size_t index, int value);
+  void modbusSyncCoils();
+
+  // Modbus TCP server, requests are served from the same tables as RTU server
+  static constexpr size_t ModbusAduMax = ModbusTcp::AduMax;
+  struct ModbusConnection {
+    Client *client = nullptr;
+    uint32_t time = 0;
+    uint8_t buffer[ModbusAduMax * 2];
+    size_t length = 0;
+  };
+  EthernetServer _modbusEthernetServer;
+  WiFiServer _modbusWifiServer;
+  EthernetClient _modbusEthernetClients[OPTA2IOT_MODBUS_CLIENTS];
+  WiFiClient _modbusWifiClients[OPTA2IOT_MODBUS_CLIENTS];
+  ModbusConnection _modbusConnections[OPTA2IOT_MODBUS_CLIENTS];
+  void modbusTcpLoop();
+  void modbusTcpAccept();
+  void modbusTcpProcess(ModbusConnection &conn);
+  void modbusTcpRequest(ModbusConnection &conn, const uint8_t *request, size_t length);
+  void modbusTcpClose(ModbusConnection &conn);
+  void modbusRestart();
+
+  // Modbus client scan list engine, one request in flight
+  enum ModbusClientState {
+    ModbusClientIdle = 0,
+    ModbusClientWait
+  };
+  struct ModbusRequest {
+    uint8_t server;
+    uint8_t function;
+    uint16_t start;
+    uint16_t length;
+    uint32_t period;
+    uint32_t last;   // last request time
+    uint16_t cache;  // first value offset in cache
+    bool valid;      // cache holds a published response
+  };
+  ModbusRequest _modbusRequests[ModbusScansMax];
+  size_t _modbusRequestsNum = 0;
+  size_t _modbusRequestsNext = 0;
+  uint16_t _modbusCache[OPTA2IOT_MODBUS_CACHE];
+  byte _modbusClientState = ModbusClientState::ModbusClientIdle;
+  size_t _modbusClientCurrent = 0;
+  uint32_t _modbusClientTime = 0;
+  uint32_t _modbusClientConnectTime = 0;
+  uint16_t _modbusClientTransaction = 0;
+  uint8_t _modbusClientBuffer[ModbusAduMax];
+  size_t _modbusClientLength = 0;
+  WiFiClient _modbusWifiClient;
+  bool _modbusConnectThreaded = false;
+  bool _modbusConnecting = false;              // waiting for connect thread
+  Client *_modbusConnectClient = nullptr;
+  IPAddress _modbusConnectIp;
+  uint16_t _modbusConnectPort = 0;
+  volatile bool _modbusConnectDone = false;
+  volatile bool _modbusConnectResult = false;
+  rtos::EventFlags _modbusConnectFlags;
+  void modbusConnectThread();
+  void modbusScanSetup();
+  void modbusClientLoop();
+  Client *modbusClientConnection();
+  void modbusClientSend(ModbusRequest &request);
+  int modbusClientReceive(ModbusRequest &request);
+  void modbusClientStore(ModbusRequest &request, const uint8_t *data);
+  static uint16_t modbusCrc(const uint8_t *data, size_t length);
   bool modbusGetRegisters(int *response, uint8_t type, uint8_t server, size_t start, size_t length);
 
   // MQTT
 
+  enum MqttState {
+    MqttStateIdle = 0,
+    MqttStateConnecting,   // waiting for connect thread
+    MqttStateSubscribing,  // subscribing topics, one per loop
+    MqttStateConnected
+  };
+
   uint32_t _mqttLastRetry = 0;
   bool _mqttConnected = false;
+  byte _mqttState = MqttState::MqttStateIdle;
+  size_t _mqttSubscribeIndex = 0;
+  String _mqttConnectHost;
+  volatile bool _mqttConnectDone = false;
+  volatile bool _mqttConnectResult = false;
+  rtos::EventFlags _mqttConnectFlags;
+  void mqttConnectThread();
+  bool mqttSubscribeNext();
   EthernetClient mqttEthernetClient;
   WiFiClient mqttWifiClient;
   MqttClient mqttClient = nullptr;
   bool mqttSetConnected(bool connected);
   void mqttConnect();
-  void mqttReceive(String &topic, String &payload);
+  void mqttRestart();
+  bool _mqttRestart = false;
+
+  // topics are built once from base and device id, one fixed size slot per topic
+  enum MqttInputTopic {
+    MqttInputVal = 0,
+    MqttInputType,
+    MqttInputCount,
+    MqttInputTopicsNum
+  };
+
+  enum MqttTopic {
+    MqttTopicRoot = 0,        // <base><id>/
+    MqttTopicDeviceGet,
+    MqttTopicPerfGet,
+    MqttTopicDeviceType,
+    MqttTopicDeviceIp,
+    MqttTopicDeviceRevision,
+    MqttTopicPerf,
+    MqttTopicInputs,
+    MqttTopicJournal,
+    MqttTopicRs485Tx,
+    MqttTopicRs485Rx,
+    MqttTopicInput,           // I<n>/val, I<n>/type, I<n>/count for each input
+    MqttTopicOutput = MqttTopicInput + MqttInputTopicsNum * sizeof(BoardInputs) / sizeof(BoardInputs[0]),  // O<n> for each output
+    MqttTopicsNum = MqttTopicOutput + sizeof(BoardOutputs) / sizeof(BoardOutputs[0])
+  };
+
+  static const size_t MqttTopicSize = sizeof(ConfigRecord::mqttBase) + sizeof(ConfigRecord::deviceId) + 16;
+  char _mqttTopics[MqttTopicsNum][MqttTopicSize];
+  size_t _mqttRootLength = 0;
+  void mqttSetTopics();
+  const char *mqttTopic(size_t topic) const;
+  const char *mqttInputTopic(size_t index, size_t field) const;
+  struct MqttHandler {
+    char pattern[OPTA2IOT_MQTT_PATTERN_SIZE];
+    MqttCallback callback;
+    void *context;
+  };
+
+  MqttHandler _mqttHandlers[OPTA2IOT_MQTT_HANDLERS];
+  size_t _mqttHandlersNum = 0;
+  uint8_t _mqttRxBuffer[OPTA2IOT_MQTT_RX_SIZE + 1];  // one more byte for null terminator
+  size_t _mqttRxSize = 0;    // payload size of message being read, 0 if none
+  size_t _mqttRxLength = 0;  // payload bytes already read
+  uint32_t _mqttRxStart = 0;
+  void mqttRead();
+  void mqttReceive(const MqttMessage &message);
+  void mqttPublishBatch(JsonDocument &batch);
 
   // Web
 
+  enum WebState {
+    WebStateIdle = 0,
+    WebStateRequest,
+    WebStateSend,
+    WebStateEvents,
+    WebStateSocket
+  };
+
+  enum WebRoute {
+    WebRouteError = 0,
+    WebRouteHome,
+    WebRouteDevice,
+    WebRouteStyle,
+    WebRouteFavicon,
+    WebRouteConfig,
+    WebRouteData,
+    WebRouteEvents,
+    WebRouteSocket,
+    WebRoutePerf,
+    WebRoutePublish,
+    WebRouteForm
+  };
+
+  struct WebConnection {
+    Client *client = nullptr;
+    byte state = WebStateIdle;
+    byte route = WebRouteError;
+    HttpRequest<OPTA2IOT_WEB_LINE> request;
+    uint32_t time = 0;
+    const uint8_t *data = nullptr;    // response body streamed from flash
+    size_t dataLength = 0;
+    WebSocketReader<OPTA2IOT_WEB_FRAME> socket;
+  };
+
   bool _webConnected = false;
   EthernetServer webEthernetServer;
   WiFiServer webWifiServer;
-  void webConnect(Client *&client);
-  void webSendAuth(Client *&client);
-  void webSendError(Client *&client);
-  void webSendFavicon(Client *&client);
-  void webSendStyle(Client *&client);
-  void webSendHome(Client *&client);
-  void webSendDevice(Client *&client);
+  EthernetClient _webEthernetClients[OPTA2IOT_WEB_CLIENTS];
+  WiFiClient _webWifiClients[OPTA2IOT_WEB_CLIENTS];
+  WebConnection _webConnections[OPTA2IOT_WEB_CLIENTS];
+  HttpBody<OPTA2IOT_WEB_BODY> _webBody;  // one request body at a time
+  char _webAuth[(sizeof(ConfigRecord::deviceUser) + sizeof(ConfigRecord::devicePassword) + 1) / 3 * 4 + 1];  // base64 of user:password and null
+  static_assert(OPTA2IOT_WEB_LINE >= 21 + sizeof(_webAuth), "Web line must fit an Authorization header with the longest credentials");
+  uint32_t _webEventsLast = 0;
+  char _webEvent[OPTA2IOT_WEB_EVENT];  // live data serialized once for all clients
+  size_t webSerializeEvent(uint64_t inputs, uint64_t outputs);
+  bool _webEventsMqtt = false;
+  void webEvents();
+  void webDataToJson(JsonDocument &doc, uint64_t inputs, uint64_t outputs);
+  void webSetAuth();
+  void webAccept();
+  void webProcess(WebConnection &conn);
+  void webRead(WebConnection &conn);
+  void webParseRequest(WebConnection &conn);
+  void webRespond(WebConnection &conn);
+  void webWrite(WebConnection &conn);
+  void webClose(WebConnection &conn);
+  void webSendHeaders(Client *&client, const char *status, const char *type, size_t length, const char *extra = "");
+  void webSendStream(WebConnection &conn, const char *status, const char *type, const void *data, size_t length, const char *extra = "");
+  void webSendAsset(WebConnection &conn, const char *type, const void *raw, size_t rawLength, const uint8_t *gz, size_t gzLength, const char *etag, uint32_t maxAge);
+  void webSendStatus(Client *&client, const char *status, bool success, const char *message, const char *extra = "");
+  void webSendAuth(WebConnection &conn);
+  void webSendError(WebConnection &conn);
+  void webSendFavicon(WebConnection &conn);
+  void webSendStyle(WebConnection &conn);
+  void webSendHome(WebConnection &conn);
+  void webSendDevice(WebConnection &conn);
   void webSendConfig(Client *&client);
   void webSendData(Client *&client);
-  void webReceiveConfig(Client *&client);
+  void webSendEvents(WebConnection &conn);
+  void webSendSocket(WebConnection &conn);
+  bool webSocketOrigin(WebConnection &conn);
+  void webSocketRead(WebConnection &conn);
+  void webSocketFrame(WebConnection &conn);
+  void webSocketWrite(Client *&client, uint8_t opcode, const void *data, size_t length);
+  void webSocketClose(WebConnection &conn, uint16_t code);
+  void webSendPerf(Client *&client);
+  void webReceiveConfig(Client *&client, const char *body, size_t length);
   void webReceivePublish(Client *&client);
 
 };  // class Opta
@@ -0,0 +1,90 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_RECONNECT_H
+#define OPTA2IOT_RECONNECT_H
+
+#include <stdint.h>
+#include <atomic>
+
+namespace opta2iot {
+
+/* Background reconnection state.
+ *
+ * Loop side starts an attempt when one is due and collects its result, a worker thread runs the blocking connect
+ * and reports it with finish(). First attempt after a connection loss is immediate, failed ones are retried
+ * after the interval (0 disables retries). Time is always given by caller, so it can run on host with a fake clock.
+ */
+class Reconnect {
+
+public:
+
+  explicit Reconnect(uint32_t interval)
+    : _interval(interval) {}
+
+  // Loop side, a new attempt should be started
+  bool due(uint32_t now) const {
+    return _interval > 0 && !_connecting && (!_waiting || now - _last > _interval);
+  }
+
+  // Loop side, an attempt is handed to the worker
+  void start(uint32_t now) {
+    _last = now;
+    _waiting = true;
+    _connecting = true;
+    _done.store(false, std::memory_order_release);
+  }
+
+  // Loop side, an attempt is running
+  bool connecting() const {
+    return _connecting;
+  }
+
+  // Loop side, get result once the running attempt is over
+  bool finished(bool &result) {
+    if (!_connecting || !_done.load(std::memory_order_acquire)) {
+      return false;
+    }
+    _connecting = false;
+    result = _result;
+
+    return true;
+  }
+
+  // Loop side, connection is up, do not wait on next loss
+  void connected() {
+    _waiting = false;
+  }
+
+  // Worker side, attempt is over
+  void finish(bool result) {
+    _result = result;
+    _done.store(true, std::memory_order_release);
+  }
+
+private:
+
+  uint32_t _interval;
+  uint32_t _last = 0;
+  bool _waiting = false;
+  bool _connecting = false;
+  bool _result = false;
+  std::atomic<bool> _done{ false };
+
+};  // class Reconnect
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_RECONNECT_H
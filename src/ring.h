@@ -0,0 +1,105 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_RING_H
+#define OPTA2IOT_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace opta2iot {
+
+/* Lock free ring buffer.
+ *
+ * Single producer (for example an interrupt) and single consumer (the loop), no lock and no allocation.
+ * Size must be a power of 2.
+ */
+template <typename T, size_t N>
+class Ring {
+
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Ring size must be a power of 2");
+
+public:
+
+  // Producer side, returns false if ring is full
+  bool push(const T &item) {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= N) {
+      return false;
+    }
+    _items[head & (N - 1)] = item;
+    _head.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  // Consumer side, returns false if ring is empty
+  bool pop(T &item) {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = _items[tail & (N - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  // Consumer side, get item at given position from tail without removing it
+  const T *peek(size_t offset = 0) const {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (offset >= _head.load(std::memory_order_acquire) - tail) {
+      return nullptr;
+    }
+
+    return &_items[(tail + offset) & (N - 1)];
+  }
+
+  // Consumer side, remove given number of items
+  void skip(size_t count) {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t used = _head.load(std::memory_order_acquire) - tail;
+    _tail.store(tail + (count < used ? count : used), std::memory_order_release);
+  }
+
+  // Consumer side, drop all items
+  void clear() {
+    _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  size_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  static constexpr size_t capacity() {
+    return N;
+  }
+
+private:
+
+  T _items[N];
+  std::atomic<size_t> _head{ 0 };
+  std::atomic<size_t> _tail{ 0 };
+
+};  // class Ring
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_RING_H
@@ -0,0 +1,240 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_RS485_H
+#define OPTA2IOT_RS485_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include "ring.h"
+
+namespace opta2iot {
+
+/* RS485 received frames.
+ *
+ * Bytes are drained from any source with Arduino Stream available() and read(), split into frames
+ * on bus silence, on a delimiter or on a length prefix, then stored contiguously for a single reader.
+ * Each byte is timed when it is drained: bytes found waiting together are timed back one character
+ * time apart from drain time, as they arrived at the latest, so a silence followed by a frame is
+ * measured even when drain is late. A silence between or after bytes that waited together cannot
+ * be seen, drain must run more often than the shortest silence to find. No allocation, it can run on host.
+ */
+template <size_t Size, size_t Frames>
+class Rs485Receiver {
+
+  static_assert(Size <= 0xFFFF, "RS485 frames buffer is addressed on 16 bits");
+
+public:
+
+  enum Framing {
+    FramingGap = 0,    // frame ends on bus silence, parameter is silence in microseconds (0 = t3.5)
+    FramingDelimiter,  // frame ends with delimiter byte given as parameter, delimiter is not part of frame
+    FramingLength      // first byte is frame length, parameter is maximum silence inside frame in microseconds (0 = none)
+  };
+
+  // Producer side, drop current frame and use new framing
+  void begin(uint8_t framing, uint32_t parameter) {
+    _framing = framing;
+    _parameter = parameter;
+    _write = _start;
+    _expected = -1;
+    _drop = false;
+  }
+
+  uint8_t framing() const {
+    return _framing;
+  }
+
+  uint32_t parameter() const {
+    return _parameter;
+  }
+
+  // Producer side, read waiting bytes or end frame on silence, times are in microseconds, get number of read bytes
+  template <class Source>
+  size_t drain(Source &source, uint32_t now, uint32_t charTime, uint32_t t35) {
+    int available = source.available();
+    size_t count = 0;
+    while (count < (size_t)(available > 0 ? available : 0)) {
+      int value = source.read();
+      if (value < 0) {
+        break;
+      }
+
+      // latest possible arrival, but not before previous byte
+      uint32_t arrival = now - (available - 1 - count) * charTime;
+      if ((int32_t)(arrival - _last) < 0) {
+        arrival = _last;
+      }
+      receive(value, arrival, t35);
+      count++;
+    }
+    if (count == 0) {
+      silence(now, t35);
+    }
+
+    return count;
+  }
+
+  // Consumer side, view of a received frame, valid until release()
+  bool peek(const uint8_t *&data, size_t &length, size_t index = 0) const {
+    const Span *span = _frames.peek(index);
+    if (!span) {
+      return false;
+    }
+    data = _buffer + span->start;
+    length = span->length;
+
+    return true;
+  }
+
+  // Consumer side, drop oldest received frame
+  void release() {
+    const Span *span = _frames.peek();
+    if (span) {
+      size_t end = span->start + span->length;
+      _frames.skip(1);
+      _read.store(end, std::memory_order_release);
+    }
+  }
+
+  size_t size() const {
+    return _frames.size();
+  }
+
+  bool empty() const {
+    return _frames.empty();
+  }
+
+  // Number of received frames lost
+  uint32_t overruns() const {
+    return _overruns.load(std::memory_order_relaxed);
+  }
+
+private:
+
+  // received frames are stored contiguously, a frame reaching the end of buffer is moved to its start
+  struct Span {
+    uint16_t start;
+    uint16_t length;
+  };
+  uint8_t _buffer[Size];
+  Ring<Span, Frames> _frames;
+  std::atomic<size_t> _read{ 0 };  // end of last released frame, written by reader
+  std::atomic<uint32_t> _overruns{ 0 };
+  size_t _start = 0;               // current frame start
+  size_t _write = 0;
+  int _expected = -1;              // remaining bytes of length prefixed frame, -1 waiting length
+  bool _drop = false;              // current frame does not fit, dropped at its end
+  uint32_t _last = 0;              // arrival of last byte
+  uint8_t _framing = FramingGap;
+  uint32_t _parameter = 0;
+
+  bool partial() const {
+    return _write != _start || _drop || _expected >= 0;
+  }
+
+  // end or drop current frame if bus was silent long enough since last byte
+  void silence(uint32_t time, uint32_t t35) {
+    if (!partial()) {
+      return;
+    }
+    if (_framing == FramingGap && time - _last >= (_parameter > 0 ? _parameter : t35)) {
+      end();
+    } else if (_framing == FramingLength && _parameter > 0 && time - _last >= _parameter) {
+      _write = _start;  // uncompleted frame, resync on next length
+      _expected = -1;
+      _drop = false;
+      _overruns++;
+    }
+  }
+
+  void receive(uint8_t value, uint32_t arrival, uint32_t t35) {
+    silence(arrival, t35);
+    _last = arrival;
+
+    switch (_framing) {
+      case FramingDelimiter:
+        if (value == (uint8_t)_parameter) {
+          end();
+        } else {
+          store(value);
+        }
+        break;
+
+      case FramingLength:
+        if (_expected < 0) {
+          _expected = value;
+        } else {
+          store(value);
+          _expected--;
+        }
+        if (_expected == 0) {
+          end();
+          _expected = -1;
+        }
+        break;
+
+      default:
+        store(value);
+    }
+  }
+
+  void store(uint8_t value) {
+    if (_drop) {
+      return;
+    }
+
+    size_t read = _read.load(std::memory_order_acquire);
+    if (_write >= read) {
+      if (_write == Size) {
+        // end of buffer, current frame goes to start if released frames left room
+        size_t length = _write - _start;
+        if (length + 1 >= read) {
+          _drop = true;
+
+          return;
+        }
+        memmove(_buffer, _buffer + _start, length);
+        _start = 0;
+        _write = length;
+      }
+    } else if (_write + 1 >= read) {
+      _drop = true;  // reader is late
+
+      return;
+    }
+
+    _buffer[_write++] = value;
+  }
+
+  void end() {
+    if (_drop || (_write > _start && !_frames.push({ (uint16_t)_start, (uint16_t)(_write - _start) }))) {
+      _write = _start;
+      _drop = false;
+      _overruns++;
+
+      return;
+    }
+
+    _start = _write;
+  }
+
+};  // class Rs485Receiver
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_RS485_H
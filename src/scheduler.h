@@ -0,0 +1,143 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_SCHEDULER_H
+#define OPTA2IOT_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace opta2iot {
+
+/* Deadline driven tasks scheduler.
+ *
+ * Tasks are registered with a period, the order of registration gives the priority (first = highest).
+ * Scheduler does not read any clock, time is always given by caller, so it can run on host with a fake clock.
+ */
+class Scheduler {
+
+public:
+
+  static const size_t TasksMax = 16;
+
+  // Add a task, first added task has the highest priority
+  bool add(uint8_t id, uint32_t period, uint32_t now) {
+    if (_tasksNum >= TasksMax) {
+      return false;
+    }
+    _tasks[_tasksNum].id = id;
+    _tasks[_tasksNum].period = period;
+    _tasks[_tasksNum].deadline = now;  // first run as soon as possible
+    _tasks[_tasksNum].enabled = true;
+    _tasksNum++;
+
+    return true;
+  }
+
+  // Get the highest priority task that is due and set its next deadline, or -1 if nothing is due
+  int next(uint32_t now) {
+    for (size_t i = 0; i < _tasksNum; i++) {
+      Task &task = _tasks[i];
+      if (task.enabled && due(task, now)) {
+        // keep a steady rate, but never try to catch up missed periods
+        task.deadline += task.period;
+        if (due(task, now)) {
+          task.deadline = now + task.period;
+        }
+
+        return task.id;
+      }
+    }
+
+    return -1;
+  }
+
+  // Get time until the earliest deadline, 0 if a task is already due
+  uint32_t idle(uint32_t now, uint32_t max) const {
+    uint32_t ret = max;
+    for (size_t i = 0; i < _tasksNum; i++) {
+      const Task &task = _tasks[i];
+      if (!task.enabled) {
+        continue;
+      }
+      if (due(task, now)) {
+        return 0;
+      }
+      if (task.deadline - now < ret) {
+        ret = task.deadline - now;
+      }
+    }
+
+    return ret;
+  }
+
+  // Make a task due right now
+  void wake(uint8_t id, uint32_t now) {
+    Task *task = find(id);
+    if (task) {
+      task->deadline = now;
+    }
+  }
+
+  void setPeriod(uint8_t id, uint32_t period) {
+    Task *task = find(id);
+    if (task) {
+      task->period = period;
+    }
+  }
+
+  void setEnabled(uint8_t id, bool on) {
+    Task *task = find(id);
+    if (task) {
+      task->enabled = on;
+    }
+  }
+
+  size_t size() const {
+    return _tasksNum;
+  }
+
+private:
+
+  struct Task {
+    uint8_t id;
+    bool enabled;
+    uint32_t period;
+    uint32_t deadline;
+  };
+
+  Task _tasks[TasksMax];
+  size_t _tasksNum = 0;
+
+  // wrap around safe deadline check
+  static bool due(const Task &task, uint32_t now) {
+    return (int32_t)(now - task.deadline) >= 0;
+  }
+
+  Task *find(uint8_t id) {
+    for (size_t i = 0; i < _tasksNum; i++) {
+      if (_tasks[i].id == id) {
+        return &_tasks[i];
+      }
+    }
+
+    return nullptr;
+  }
+
+};  // class Scheduler
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_SCHEDULER_H
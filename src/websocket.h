@@ -0,0 +1,168 @@
+/* opta2iot
+ *
+ * Arduino Opta Industrial IoT gateway
+ *
+ * Author: Jean-Christian Paul Denis
+ * Source: https://github.com/JcDenis/opta2iot
+ *
+ * Based on "Remoto" at https://github.com/albydnc/remoto by
+ * Author: Alberto Perro
+ * Date: 27-12-2024
+ * License: CERN-OHL-P
+ *
+ * see README.md file
+ */
+
+#ifndef OPTA2IOT_WEBSOCKET_H
+#define OPTA2IOT_WEBSOCKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace opta2iot {
+
+/* Incremental WebSocket frames reader (RFC 6455).
+ *
+ * Client frames are small commands, a whole frame is collected in a fixed buffer then unmasked.
+ * Frames can arrive in any number of pieces, even inside their header. Reads from any source with
+ * Arduino Client available() and read(), within a bytes budget shared by calls. No allocation, it can run on host.
+ */
+template <size_t Size>
+class WebSocketReader {
+
+  static_assert(Size >= 8, "WebSocket frame buffer must hold the longest header");
+
+public:
+
+  enum Result {
+    SocketMore = 0,     // waiting for more data
+    SocketFrame,        // a whole frame is ready
+    SocketTooBig,       // unmasked, 64 bits length or larger than buffer, close with 1009
+    SocketProtocolError // fragmented or too long control frame, close with 1002
+  };
+
+  void begin() {
+    _length = 0;
+    _ready = false;
+  }
+
+  // Read until a whole frame is received, budget is decreased by read bytes
+  template <class Source>
+  Result read(Source &source, size_t &budget) {
+    if (_ready) {  // previous frame was handled
+      _ready = false;
+      _length = 0;
+    }
+
+    while (budget > 0 && source.available() > 0) {
+      size_t total = need(_frame, _length);
+      if (total == 0) {
+        return SocketTooBig;
+      }
+
+      int read = source.read(_frame + _length, total - _length < budget ? total - _length : budget);
+      if (read <= 0) {
+        break;
+      }
+      budget -= read;
+      _length += read;
+      _consumed += read;
+
+      if (_length >= 2 && _length == need(_frame, _length)) {
+        if ((opcode() & 0x8) && (!fin() || (_frame[1] & 0x7F) > 125)) {
+          return SocketProtocolError;
+        }
+        unmask();
+        _ready = true;
+
+        return SocketFrame;
+      }
+    }
+
+    return SocketMore;
+  }
+
+  bool fin() const {
+    return _frame[0] & 0x80;
+  }
+
+  uint8_t opcode() const {
+    return _frame[0] & 0x0F;
+  }
+
+  // Unmasked payload of a ready frame
+  uint8_t *payload() {
+    return _frame + header() + 4;
+  }
+
+  size_t size() const {
+    return _length - header() - 4;
+  }
+
+  // Total bytes read from source, to track client activity
+  size_t consumed() const {
+    return _consumed;
+  }
+
+  // Get frame length known from already received bytes, 0 if frame is not supported
+  static size_t need(const uint8_t *frame, size_t length) {
+    if (length < 2) {
+      return 2;
+    }
+    size_t payload = frame[1] & 0x7F;
+    size_t total = 2 + 4;
+    if (!(frame[1] & 0x80) || payload == 127) {
+      return 0;
+    }
+    if (payload == 126) {
+      total += 2;
+      if (length < 4) {
+        return total;  // extended length not received yet
+      }
+      payload = (frame[2] << 8) | frame[3];
+    }
+    total += payload;
+
+    return total <= Size ? total : 0;
+  }
+
+  // Write a server frame header, never masked nor fragmented, get its length
+  static size_t header(uint8_t *out, uint8_t opcode, size_t length) {
+    out[0] = 0x80 | opcode;
+    if (length > 125) {
+      out[1] = 126;
+      out[2] = length >> 8;
+      out[3] = length & 0xFF;
+
+      return 4;
+    }
+    out[1] = length;
+
+    return 2;
+  }
+
+private:
+
+  uint8_t _frame[Size];
+  size_t _length = 0;
+  size_t _consumed = 0;
+  bool _ready = false;
+
+  size_t header() const {
+    return (_frame[1] & 0x7F) == 126 ? 4 : 2;
+  }
+
+  void unmask() {
+    const uint8_t *mask = _frame + header();
+    uint8_t *data = payload();
+    size_t length = size();
+    for (size_t i = 0; i < length; i++) {
+      data[i] ^= mask[i % 4];
+    }
+  }
+
+};  // class WebSocketReader
+
+}  // namespace opta2iot
+
+#endif  // #ifndef OPTA2IOT_WEBSOCKET_H